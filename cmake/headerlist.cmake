@@ -9,6 +9,10 @@ set(headers ${headers}
     src/higgsinterface001.h
     src/ShackleModeManager.h
     src/ClimbManager.h
+    src/FrameContext.h
+    src/HandPosePredictor.h
+    src/GrabReadinessTracker.h
+    src/SessionRecorder.h
     src/ClimbSurfaceDetector.h
     src/BallisticController.h
     src/CriticalStrikeManager.h
@@ -19,10 +23,21 @@ set(headers ${headers}
     src/ClimbExitCorrector.h
     src/AudioManager.h
     src/HavokUtils.h
+    src/VelocityHistory.h
+    src/FixedTimestep.h
+    src/OneEuroFilter.h
+    src/ClimbSmoother.h
+    src/SpscQueue.h
     src/util/VRNodes.h
     src/util/Raycast.h
+    src/util/QueryBackend.h
+    src/util/HavokQueryBackend.h
+    src/util/QueryScheduler.h
+    src/util/TickRegistry.h
+    src/util/SessionStream.h
+    src/util/QueryRecorder.h
     external/PapyrusVRAPI.h
     external/VRManagerAPI.h
     external/PapyrusVRTypes.h
     external/VRHookAPI.h
-)
\ No newline at end of file
+)
\ No newline at end of file
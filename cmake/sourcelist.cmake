@@ -7,6 +7,10 @@ set(sources ${sources}
     src/ShackleModeManager.cpp
     src/HavokUtils.cpp
     src/ClimbManager.cpp
+    src/FrameContext.cpp
+    src/HandPosePredictor.cpp
+    src/GrabReadinessTracker.cpp
+    src/SessionRecorder.cpp
     src/ClimbSurfaceDetector.cpp
     src/BallisticController.cpp
     src/CriticalStrikeManager.cpp
@@ -18,4 +22,10 @@ set(sources ${sources}
     src/MenuChecker.cpp
     src/AudioManager.cpp
     src/util/Raycast.cpp
-)
\ No newline at end of file
+    src/util/QueryBackend.cpp
+    src/util/HavokQueryBackend.cpp
+    src/util/QueryScheduler.cpp
+    src/util/TickRegistry.cpp
+    src/util/SessionStream.cpp
+    src/util/QueryRecorder.cpp
+)
\ No newline at end of file
@@ -7,14 +7,12 @@
 #include "Config.h"
 #include "util/Raycast.h"
 #include "util/VRNodes.h"
+#include "util/TickRegistry.h"
 #include <RE/B/bhkCharProxyController.h>
 #include <RE/H/hkpCharacterProxy.h>
 #include <spdlog/spdlog.h>
 #include <cmath>
 
-// Frame counter for CriticalStrikeManager throttling
-static uint32_t s_frameCount = 0;
-
 // Layer filter - only land on solid world geometry
 static bool IsGroundLayer(RE::COL_LAYER layer)
 {
@@ -90,6 +88,7 @@ void BallisticController::Launch(const RE::NiPoint3& velocity, float gravity)
 
     m_flightTime = 0.0f;
     m_inFlight = true;
+    TickRegistry::Subscribe(TickRegistry::Tick::kBallisticFlight);
     m_launchVelocity = velocity;  // Store for exit correction speed checks																			 
     m_autoCatchResult = AutoCatchHand::kNone;  // Clear any previous auto-catch result
     // Note: m_needsExitCorrection is set by ClimbManager via RequestExitCorrection()
@@ -232,6 +231,7 @@ void BallisticController::StartFall(float gravity)
     m_velocity = RE::NiPoint3{ 0.0f, 0.0f, 0.0f };
     m_flightTime = 0.0f;
     m_inFlight = true;
+    TickRegistry::Subscribe(TickRegistry::Tick::kBallisticFlight);
 
     m_autoCatchResult = AutoCatchHand::kNone;
 
@@ -264,26 +264,20 @@ void BallisticController::StartFall(float gravity)
         m_gravity, m_hadInitialSupport);
 }
 
-bool BallisticController::Update(float deltaTime)
+bool BallisticController::Update(const FrameContext& frame, float deltaTime)
 {
     if (!m_inFlight) {
         return false;
     }
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        Abort();
-        return false;
-    }
-
-    auto* controller = player->GetCharController();
-    if (!controller) {
+    auto* player = frame.player;
+    auto* controller = frame.controller;
+    if (!player || !controller) {
         Abort();
         return false;
     }
 
     m_flightTime += deltaTime;
-    s_frameCount++;
 
     // Update clearance tracking
     m_clearanceTimer += deltaTime;
@@ -313,7 +307,8 @@ bool BallisticController::Update(float deltaTime)
         floorCheckOrigin.z += FLOOR_CHECK_HEIGHT;
         RE::NiPoint3 downDir = { 0.0f, 0.0f, -1.0f };
 
-        RaycastResult floorCheck = Raycast::CastRay(floorCheckOrigin, downDir, FLOOR_CHECK_DISTANCE);
+        RAYCAST_QUERY_SITE(kGhostFloor);
+        RaycastResult floorCheck = Raycast::CastRay(floorCheckOrigin, downDir, FLOOR_CHECK_DISTANCE, LayerMasks::kAll, RaycastOutputs::kLayer);
         if (floorCheck.hit && IsGroundLayer(floorCheck.collisionLayer)) {
             // Ground surface is at: floorCheckOrigin.z - floorCheck.distance
             float groundZ = floorCheckOrigin.z - floorCheck.distance;
@@ -331,13 +326,13 @@ bool BallisticController::Update(float deltaTime)
     }
 
     // Update CriticalStrikeManager for enemy detection
-    CriticalStrikeManager::GetSingleton()->Update(s_frameCount);
+    CriticalStrikeManager::GetSingleton()->Update(frame);
 
     // Track safe positions for exit correction fallback (every 50 frames)
     ClimbExitCorrector::GetSingleton()->UpdateSafePositionCheck();
 
-    // Read current velocity from controller
-    float havokScale = RE::bhkWorld::GetWorldScale();
+    // Read current velocity from controller (read-modify-write, so not the frame's copy)
+    float havokScale = frame.havokWorldScale;
     RE::hkVector4 hkVelocity;
     controller->GetLinearVelocityImpl(hkVelocity);
 
@@ -375,13 +370,13 @@ bool BallisticController::Update(float deltaTime)
 
         // Also force correction if penetration is too deep
         if (!shouldCorrect && Config::options.exitCorrectionMaxPenetration > 0.0f) {
-            auto* hmd = VRNodes::GetHMD();
-            if (hmd) {
-                RE::NiPoint3 hmdPos = hmd->world.translate;
+            if (frame.hasHmd) {
+                RE::NiPoint3 hmdPos = frame.hmd.translate;
                 RE::NiPoint3 downDir = { 0.0f, 0.0f, -1.0f };
                 constexpr float RAY_DISTANCE = 200.0f;
 
-                RaycastResult groundCheck = Raycast::CastRay(hmdPos, downDir, RAY_DISTANCE);
+                RAYCAST_QUERY_SITE(kLandingPenetration);
+                RaycastResult groundCheck = Raycast::CastRay(hmdPos, downDir, RAY_DISTANCE, LayerMasks::kAll, RaycastOutputs::kNone);
                 if (groundCheck.hit) {
                     constexpr float HMD_TO_FEET = 120.0f;
                     float feetZ = hmdPos.z - HMD_TO_FEET;
@@ -399,7 +394,7 @@ bool BallisticController::Update(float deltaTime)
 
         if (shouldCorrect) {
             spdlog::info("BallisticController: Starting exit correction, speed: {:.1f}, falling: {}", currentSpeed, isFalling);
-            ClimbExitCorrector::GetSingleton()->StartCorrection(m_launchVelocity);
+            ClimbExitCorrector::GetSingleton()->StartCorrection(frame, m_launchVelocity);
             m_needsExitCorrection = false;
         }
     }
@@ -415,7 +410,7 @@ bool BallisticController::Update(float deltaTime)
     bool velocityAllowsLanding = (Config::options.maxLandingVelocity <= 0.0f) ||
         (currentSpeed <= Config::options.maxLandingVelocity);
 
-    if (m_flightTime >= Config::options.minFlightTime && velocityAllowsLanding && CheckLanding()) {
+    if (m_flightTime >= Config::options.minFlightTime && velocityAllowsLanding && CheckLanding(frame)) {
         spdlog::info("=== BALLISTIC MODE: EXIT (landed) === flight time: {:.2f}s, landing speed: {:.1f}", m_flightTime, currentSpeed);
 
         // Re-enable collision (ghost mode off)
@@ -459,7 +454,7 @@ bool BallisticController::Update(float deltaTime)
 
     // Check for auto-catch opportunity (after minimum time, only while descending)
     if (m_flightTime >= AUTO_CATCH_MIN_TIME && m_velocity.z < 0.0f) {
-        AutoCatchHand catchResult = CheckAutoCatch();
+        AutoCatchHand catchResult = CheckAutoCatch(frame);
         if (catchResult != AutoCatchHand::kNone) {
             float speed = std::sqrt(m_velocity.x * m_velocity.x + m_velocity.y * m_velocity.y + m_velocity.z * m_velocity.z);
             spdlog::info("=== BALLISTIC MODE: EXIT (auto-catch {}) === flight time: {:.2f}s, speed: {:.1f}",
@@ -501,14 +496,9 @@ bool BallisticController::Update(float deltaTime)
     return true;  // Still in flight
 }
 
-bool BallisticController::CheckLanding() const
+bool BallisticController::CheckLanding(const FrameContext& frame) const
 {
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return true;  // Abort if no player
-    }
-
-    auto* controller = player->GetCharController();
+    auto* controller = frame.controller;
     if (!controller) {
         return true;  // Abort if no controller
     }
@@ -596,6 +586,7 @@ RE::NiPoint3 BallisticController::PredictLandingPosition() const
 
     // Simple prediction: simulate until Z velocity goes negative and we're below start
     // This is a rough estimate - could be improved with actual ground raycasting
+    RAYCAST_QUERY_SITE(kLandingPrediction);
     float t = 0.0f;
     constexpr float dt = 0.05f;  // 50ms steps
     constexpr float maxTime = 10.0f;  // Max prediction time
@@ -610,7 +601,7 @@ RE::NiPoint3 BallisticController::PredictLandingPosition() const
         // Simple ground check at predicted position
         if (vel.z < 0.0f) {
             RE::NiPoint3 down{ 0.0f, 0.0f, -1.0f };
-            RaycastResult result = Raycast::CastRay(pos, down, 50.0f);
+            RaycastResult result = Raycast::CastRay(pos, down, 50.0f, LayerMasks::kAll, RaycastOutputs::kNone);
             if (result.hit && result.distance < 20.0f) {
                 pos.z = result.hitPoint.z;
                 return pos;
@@ -639,32 +630,44 @@ bool BallisticController::IsInAutoCatchWindow() const
     return elapsed < POST_FLIGHT_AUTOCATCH_DURATION;
 }
 
-BallisticController::AutoCatchHand BallisticController::CheckAutoCatch() const
+BallisticController::AutoCatchHand BallisticController::CheckAutoCatch(const FrameContext& frame) const
 {
     uint8_t result = AutoCatchHand::kNone;
+    RAYCAST_QUERY_SITE(kAutoCatch);
 
     // Beast forms (werewolf/vampire lord) can grab in any direction
     // Normal players only check downward
-    if (ClimbManager::IsPlayerInBeastForm()) {
+    if (frame.isBeastForm) {
         // Use full multi-directional surface detection for beast forms
-        if (ClimbSurfaceDetector::CanGrabSurface(true)) {
+        if (ClimbSurfaceDetector::CanGrabSurface(frame, true)) {
             result |= AutoCatchHand::kLeft;
         }
-        if (ClimbSurfaceDetector::CanGrabSurface(false)) {
+        if (ClimbSurfaceDetector::CanGrabSurface(frame, false)) {
             result |= AutoCatchHand::kRight;
         }
+        return static_cast<AutoCatchHand>(result);
+    }
 
+    // Normal players: cast rays world-down only, both hands in a single ray batch
+    static const RE::NiPoint3 worldDown{ 0.0f, 0.0f, -1.0f };
+
+    RaycastRequest requests[2];
+    size_t leftCount = ClimbSurfaceDetector::BuildDirectionalProbe(frame, true, worldDown, requests[0]) ? 1 : 0;
+    size_t rightCount = ClimbSurfaceDetector::BuildDirectionalProbe(frame, false, worldDown, requests[leftCount]) ? 1 : 0;
+
+    size_t total = leftCount + rightCount;
+    if (total == 0) {
+        return AutoCatchHand::kNone;
     }
-    else {
-        // Normal players: cast rays world-down only
-        static const RE::NiPoint3 worldDown{ 0.0f, 0.0f, -1.0f };
 
-        if (ClimbSurfaceDetector::CastRayInDirection(true, worldDown)) {
-            result |= AutoCatchHand::kLeft;
-        }
-        if (ClimbSurfaceDetector::CastRayInDirection(false, worldDown)) {
-            result |= AutoCatchHand::kRight;
-        }
+    RaycastResult results[2];
+    Raycast::CastRays({ requests, total }, { results, total });
+
+    if (leftCount > 0 && ClimbSurfaceDetector::EvaluateProbe({ results, leftCount })) {
+        result |= AutoCatchHand::kLeft;
+    }
+    if (rightCount > 0 && ClimbSurfaceDetector::EvaluateProbe({ results + leftCount, rightCount })) {
+        result |= AutoCatchHand::kRight;
     }
 
     return static_cast<AutoCatchHand>(result);
@@ -798,7 +801,8 @@ bool BallisticController::ShouldEnterGhostMode(const RE::NiPoint3& velocity, flo
     float rayLength = travelDistance + PLAYER_SIZE_MARGIN;
 
     // Cast the ray to check for obstacles
-    RaycastResult result = Raycast::CastRay(origin, direction, rayLength);
+    RAYCAST_QUERY_SITE(kGhostPath);
+    RaycastResult result = Raycast::CastRay(origin, direction, rayLength, LayerMasks::kAll, RaycastOutputs::kLayer);
 
     if (result.hit) {
         spdlog::info("BallisticController: Ghost mode DENIED - ray hit {} at distance {:.1f} (layer {})",
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RE/Skyrim.h"
+#include "FrameContext.h"
 #include <chrono>
 
 // Controls player trajectory after launch until touchdown
@@ -21,9 +22,9 @@ public:
     // Still provides auto-catch protection while falling
     void StartFall(float gravity);
 
-    // Call every physics frame to update trajectory
+    // Call every frame to update trajectory (deltaTime may differ from frame.deltaTime at a fixed step rate)
     // Returns true if still in flight, false if landed
-    bool Update(float deltaTime);
+    bool Update(const FrameContext& frame, float deltaTime);
 
     // Check if currently controlling the player
     bool IsInFlight() const { return m_inFlight; }
@@ -79,7 +80,7 @@ public:
     // For beast forms: casts rays in all directions
     // For normal: casts rays world-down only
     // Returns which hand(s) detected a catchable surface
-    AutoCatchHand CheckAutoCatch() const;
+    AutoCatchHand CheckAutoCatch(const FrameContext& frame) const;
 
 private:
     BallisticController() = default;
@@ -88,7 +89,7 @@ private:
     BallisticController& operator=(const BallisticController&) = delete;
 
     // Check if player has landed (collision detected)
-    bool CheckLanding() const;
+    bool CheckLanding(const FrameContext& frame) const;
 
     // State
     bool m_inFlight = false;
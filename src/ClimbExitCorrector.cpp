@@ -1,7 +1,8 @@
 #include "ClimbExitCorrector.h"
 #include "Config.h"
-#include "util/VRNodes.h"
 #include "util/Raycast.h"
+#include "util/QueryScheduler.h"
+#include "util/TickRegistry.h"
 #include <spdlog/spdlog.h>
 #include <cmath>
 
@@ -11,20 +12,19 @@ ClimbExitCorrector* ClimbExitCorrector::GetSingleton()
     return &instance;
 }
 
-float ClimbExitCorrector::DetectCorrectionNeeded(RE::NiPoint3& outTargetPos)
+float ClimbExitCorrector::DetectCorrectionNeeded(const FrameContext& frame, RE::NiPoint3& outTargetPos)
 {
-    auto* player = RE::PlayerCharacter::GetSingleton();
+    auto* player = frame.player;
     if (!player) {
         return 0.0f;
     }
 
-    auto* hmd = VRNodes::GetHMD();
-    if (!hmd) {
+    if (!frame.hasHmd) {
         spdlog::warn("ClimbExitCorrector: No HMD node available");
         return 0.0f;
     }
 
-    RE::NiPoint3 hmdPos = hmd->world.translate;
+    RE::NiPoint3 hmdPos = frame.hmd.translate;
     RE::NiPoint3 playerPos = player->GetPosition();  // Feet position
 
     // Detection target: 130 units below HMD position
@@ -48,7 +48,8 @@ float ClimbExitCorrector::DetectCorrectionNeeded(RE::NiPoint3& outTargetPos)
 
     // Cast ray from HMD toward detection target (130 units down)
     // Use filtered raycast to only hit solid geometry layers
-    RaycastResult result = Raycast::CastRay(hmdPos, direction, distance, LayerMasks::kSolid);
+    RAYCAST_QUERY_SITE(kExitDetect);
+    RaycastResult result = Raycast::CastRay(hmdPos, direction, distance, LayerMasks::kSolid, RaycastOutputs::kNone);
 
     if (!result.hit) {
         // No solid geometry found
@@ -76,7 +77,8 @@ float ClimbExitCorrector::CheckHeadroomAt(const RE::NiPoint3& position, float re
     checkStart.z += 1.0f;  // Small offset to avoid self-intersection
 
     // Use filtered raycast to only consider solid geometry
-    RaycastResult headroomCheck = Raycast::CastRay(checkStart, upDir, requiredHeight + 10.0f, LayerMasks::kSolid);
+    RAYCAST_QUERY_SITE(kExitDetect);
+    RaycastResult headroomCheck = Raycast::CastRay(checkStart, upDir, requiredHeight + 10.0f, LayerMasks::kSolid, RaycastOutputs::kNone);
 
     if (headroomCheck.hit) {
         return headroomCheck.distance;  // Return available headroom
@@ -85,20 +87,17 @@ float ClimbExitCorrector::CheckHeadroomAt(const RE::NiPoint3& position, float re
     return requiredHeight + 100.0f;  // No ceiling hit - plenty of room
 }
 
-bool ClimbExitCorrector::FindHorizontalEscape(float searchDistance, RE::NiPoint3& outTargetPos)
+bool ClimbExitCorrector::FindHorizontalEscape(const FrameContext& frame, float searchDistance, RE::NiPoint3& outTargetPos)
 {
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return false;
-    }
+    RAYCAST_QUERY_SITE(kExitEscape);
 
-    auto* hmd = VRNodes::GetHMD();
-    if (!hmd) {
+    auto* player = frame.player;
+    if (!player || !frame.hasHmd) {
         return false;
     }
 
     RE::NiPoint3 playerPos = player->GetPosition();
-    RE::NiPoint3 hmdPos = hmd->world.translate;
+    RE::NiPoint3 hmdPos = frame.hmd.translate;
 
     // 8 directions: cardinals first (more likely to be valid), then diagonals
     constexpr int NUM_DIRECTIONS = 8;
@@ -116,51 +115,79 @@ bool ClimbExitCorrector::FindHorizontalEscape(float searchDistance, RE::NiPoint3
     constexpr float HEADROOM_REQUIRED = 140.0f;  // Standing player height
     constexpr float GROUND_SEARCH_DEPTH = 200.0f;
 
-    for (int i = 0; i < NUM_DIRECTIONS; i++) {
-        float dirX = directions[i][0];
-        float dirY = directions[i][1];
+    // The three checks per direction are issued as three ray batches (path, ground, headroom)
+    // across all directions, then the first valid direction in priority order is picked
+    RaycastRequest requests[NUM_DIRECTIONS];
+    RaycastResult results[NUM_DIRECTIONS];
+    int candidates[NUM_DIRECTIONS];
+    RE::NiPoint3 testPositions[NUM_DIRECTIONS];
 
-        // Calculate test position at escape distance
-        RE::NiPoint3 testPos = {
-            playerPos.x + dirX * searchDistance,
-            playerPos.y + dirY * searchDistance,
-            playerPos.z
-        };
-
-        // Check 1: Is the horizontal path clear?
-        RE::NiPoint3 horDir = {dirX, dirY, 0.0f};
-        RaycastResult pathCheck = Raycast::CastRay(playerPos, horDir, searchDistance, LayerMasks::kSolid);
+    // Check 1: Is the horizontal path clear?
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        RE::NiPoint3 horDir = {directions[i][0], directions[i][1], 0.0f};
+        requests[i] = RaycastRequest{ playerPos, horDir, searchDistance, LayerMasks::kSolid, RaycastOutputs::kNone };
+    }
+    Raycast::CastRays(requests, results);
 
-        if (pathCheck.hit && pathCheck.distance < searchDistance - 5.0f) {
+    int candidateCount = 0;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        if (results[i].hit && results[i].distance < searchDistance - 5.0f) {
             // Path is blocked by solid geometry
             continue;
         }
+        candidates[candidateCount++] = i;
+    }
 
-        // Check 2: Find ground at the escape position (cast down from HMD height)
-        RE::NiPoint3 groundCheckStart = {testPos.x, testPos.y, hmdPos.z};
-        RE::NiPoint3 downDir = {0.0f, 0.0f, -1.0f};
-        RaycastResult groundCheck = Raycast::CastRay(groundCheckStart, downDir, GROUND_SEARCH_DEPTH, LayerMasks::kSolid);
+    // Check 2: Find ground at the escape position (cast down from HMD height)
+    RE::NiPoint3 downDir = {0.0f, 0.0f, -1.0f};
+    for (int c = 0; c < candidateCount; c++) {
+        int i = candidates[c];
 
-        if (!groundCheck.hit) {
+        // Calculate test position at escape distance
+        testPositions[i] = {
+            playerPos.x + directions[i][0] * searchDistance,
+            playerPos.y + directions[i][1] * searchDistance,
+            playerPos.z
+        };
+
+        RE::NiPoint3 groundCheckStart = {testPositions[i].x, testPositions[i].y, hmdPos.z};
+        requests[c] = RaycastRequest{ groundCheckStart, downDir, GROUND_SEARCH_DEPTH, LayerMasks::kSolid, RaycastOutputs::kNone };
+    }
+    Raycast::CastRays({requests, static_cast<size_t>(candidateCount)}, {results, static_cast<size_t>(candidateCount)});
+
+    int groundedCount = 0;
+    for (int c = 0; c < candidateCount; c++) {
+        if (!results[c].hit) {
             // No valid ground at this position
             continue;
         }
 
         // Set Z to ground level
-        testPos.z = groundCheck.hitPoint.z;
+        int i = candidates[c];
+        testPositions[i].z = results[c].hitPoint.z;
+        candidates[groundedCount++] = i;
+    }
 
-        // Check 3: Verify headroom at the escape position
-        float availableHeadroom = CheckHeadroomAt(testPos, HEADROOM_REQUIRED);
+    // Check 3: Verify headroom at the escape position (same ray as CheckHeadroomAt)
+    RE::NiPoint3 upDir = {0.0f, 0.0f, 1.0f};
+    for (int c = 0; c < groundedCount; c++) {
+        RE::NiPoint3 checkStart = testPositions[candidates[c]];
+        checkStart.z += 1.0f;  // Small offset to avoid self-intersection
+        requests[c] = RaycastRequest{ checkStart, upDir, HEADROOM_REQUIRED + 10.0f, LayerMasks::kSolid, RaycastOutputs::kNone };
+    }
+    Raycast::CastRays({requests, static_cast<size_t>(groundedCount)}, {results, static_cast<size_t>(groundedCount)});
 
-        if (availableHeadroom < HEADROOM_REQUIRED) {
+    for (int c = 0; c < groundedCount; c++) {
+        if (results[c].hit && results[c].distance < HEADROOM_REQUIRED) {
             // Not enough room to stand here
             continue;
         }
 
         // Found a valid escape route!
-        outTargetPos = testPos;
+        int i = candidates[c];
+        outTargetPos = testPositions[i];
         spdlog::info("ClimbExitCorrector: Found horizontal escape at distance {:.1f}, direction ({:.2f}, {:.2f})",
-                     searchDistance, dirX, dirY);
+                     searchDistance, directions[i][0], directions[i][1]);
         return true;
     }
 
@@ -168,21 +195,21 @@ bool ClimbExitCorrector::FindHorizontalEscape(float searchDistance, RE::NiPoint3
     return false;
 }
 
-bool ClimbExitCorrector::StartCorrection(const RE::NiPoint3& initialVelocity)
+bool ClimbExitCorrector::StartCorrection(const FrameContext& frame, const RE::NiPoint3& initialVelocity)
 {
     if (isCorrecting) {
         spdlog::info(" Already correcting - skipping StartCorrection()");
         return true;
     }
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
+    auto* player = frame.player;
     if (!player) {
         return false;
     }
 
     // Check if correction is needed
     RE::NiPoint3 targetPos;
-    float correctionAmount = DetectCorrectionNeeded(targetPos);
+    float correctionAmount = DetectCorrectionNeeded(frame, targetPos);
 
     if (correctionAmount < 0.1f) {
         // No significant correction needed
@@ -196,9 +223,8 @@ bool ClimbExitCorrector::StartCorrection(const RE::NiPoint3& initialVelocity)
 
     // Calculate player's current height dynamically (HMD height above feet)
     float requiredHeight = MIN_STANDING_HEIGHT + HEADROOM_MARGIN;  // Default fallback
-    auto* hmd = VRNodes::GetHMD();
-    if (hmd) {
-        float currentPlayerHeight = hmd->world.translate.z - m_startPos.z;
+    if (frame.hasHmd) {
+        float currentPlayerHeight = frame.hmd.translate.z - m_startPos.z;
         requiredHeight = (std::max)(currentPlayerHeight, MIN_STANDING_HEIGHT) + HEADROOM_MARGIN;
     }
 
@@ -276,6 +302,7 @@ bool ClimbExitCorrector::StartCorrection(const RE::NiPoint3& initialVelocity)
 
     m_progress = 0.0f;
     isCorrecting = true;
+    TickRegistry::Subscribe(TickRegistry::Tick::kExitCorrection);
 
     spdlog::info("ClimbExitCorrector: Starting smooth correction of {:.1f} units over {:.2f}s, vel=({:.1f}, {:.1f}, {:.1f})",
                  linearDistance, m_duration,
@@ -299,25 +326,27 @@ RE::NiPoint3 ClimbExitCorrector::EvaluateBezier(float t) const
     };
 }
 
-bool ClimbExitCorrector::Update(float deltaTime)
+bool ClimbExitCorrector::Update(const FrameContext& frame)
 {
     if (!isCorrecting) {
+        TickRegistry::Unsubscribe(TickRegistry::Tick::kExitCorrection);
         return false;
     }
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
+    auto* player = frame.player;
     if (!player) {
         Cancel();
         return false;
     }
 
     // Advance progress
-    m_progress += deltaTime / m_duration;
+    m_progress += frame.deltaTime / m_duration;
 
     if (m_progress >= 1.0f) {
         // Correction complete - snap to final position
         player->SetPosition(m_targetPos, true);
         isCorrecting = false;
+        TickRegistry::Unsubscribe(TickRegistry::Tick::kExitCorrection);
 
         spdlog::info("ClimbExitCorrector: Correction complete");
         return false;
@@ -340,10 +369,16 @@ void ClimbExitCorrector::Cancel()
         isCorrecting = false;
     }
     m_progress = 0.0f;
+    TickRegistry::Unsubscribe(TickRegistry::Tick::kExitCorrection);
 }
 
 void ClimbExitCorrector::UpdateSafePositionCheck()
 {
+    // Finish a check whose rays were resolved in the physics pre-step
+    if (m_safeGroundTicket != Raycast::kInvalidTicket) {
+        CollectSafePositionCheck();
+    }
+
     // Only check every SAFE_POSITION_CHECK_INTERVAL frames to reduce raycast overhead
     m_safePositionCheckCounter++;
     if (m_safePositionCheckCounter < SAFE_POSITION_CHECK_INTERVAL) {
@@ -351,17 +386,26 @@ void ClimbExitCorrector::UpdateSafePositionCheck()
     }
     m_safePositionCheckCounter = 0;
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return;
-    }
+    // Not time-critical - let the scheduler fit it into a quiet frame
+    // The first check of a session goes ahead of other deferred work so a fallback exists early
+    auto priority = m_hasLastKnownSafePosition ? QueryScheduler::Priority::kLow : QueryScheduler::Priority::kHigh;
+    QueryScheduler::Request(QueryScheduler::Task::kSafePositionCheck, priority, [] {
+        if (const auto* frame = FrameContext::GetCurrent()) {
+            ClimbExitCorrector::GetSingleton()->RunSafePositionCheck(*frame);
+        }
+    });
+}
 
-    auto* hmd = VRNodes::GetHMD();
-    if (!hmd) {
+void ClimbExitCorrector::RunSafePositionCheck(const FrameContext& frame)
+{
+    RAYCAST_QUERY_SITE(kExitSafePosition);
+
+    auto* player = frame.player;
+    if (!player || !frame.hasHmd) {
         return;
     }
 
-    RE::NiPoint3 hmdPos = hmd->world.translate;
+    RE::NiPoint3 hmdPos = frame.hmd.translate;
     RE::NiPoint3 playerPos = player->GetPosition();  // Feet position
 
     // Calculate player's current height dynamically (HMD height above feet)
@@ -376,23 +420,69 @@ void ClimbExitCorrector::UpdateSafePositionCheck()
         m_loggedHeightThisSession = true;
     }
 
-    // Cast ray DOWN from HMD to find ground (only solid layers)
-    RE::NiPoint3 downDir = {0.0f, 0.0f, -1.0f};
-    RaycastResult groundCheck = Raycast::CastRay(hmdPos, downDir, 200.0f, LayerMasks::kSolid);
+    // Ray DOWN from HMD to find ground, and ray UP from HMD for ceiling clearance (only solid layers)
+    // Everything between the ground hit and the HMD is known to be clear, so measuring the ceiling from
+    // the HMD gives the same headroom as measuring from the ground - and lets both rays go out together
+    RaycastRequest groundRay{ hmdPos, {0.0f, 0.0f, -1.0f}, 200.0f, LayerMasks::kSolid, RaycastOutputs::kNone };
+    RaycastRequest ceilingRay{ hmdPos, {0.0f, 0.0f, 1.0f}, requiredHeight + 20.0f, LayerMasks::kSolid, RaycastOutputs::kNone };
+
+    // Not latency-critical - resolve in the physics pre-step and pick the result up next tick
+    CancelSafePositionCheck();
+    m_safeGroundTicket = Raycast::SubmitDeferred(groundRay);
+    m_safeCeilingTicket = Raycast::SubmitDeferred(ceilingRay);
+    if (m_safeGroundTicket != Raycast::kInvalidTicket && m_safeCeilingTicket != Raycast::kInvalidTicket) {
+        m_safeCheckHmdPos = hmdPos;
+        m_safeCheckPlayerPos = playerPos;
+        m_safeCheckRequiredHeight = requiredHeight;
+        return;
+    }
+
+    // Deferred queue full - cast now
+    CancelSafePositionCheck();
+    RaycastRequest requests[2] = { groundRay, ceilingRay };
+    RaycastResult results[2];
+    Raycast::CastRays(requests, results);
+    EvaluateSafePosition(hmdPos, playerPos, requiredHeight, results[0], results[1]);
+}
 
+void ClimbExitCorrector::CollectSafePositionCheck()
+{
+    // Both rays are resolved in the same batch, so the ground ticket tells us when the check is done
+    RaycastResult groundCheck;
+    if (!Raycast::TryGetDeferred(m_safeGroundTicket, groundCheck)) {
+        return;  // Still pending
+    }
+    m_safeGroundTicket = Raycast::kInvalidTicket;
+
+    RaycastResult ceilingCheck;
+    bool hasCeiling = Raycast::TryGetDeferred(m_safeCeilingTicket, ceilingCheck);
+    m_safeCeilingTicket = Raycast::kInvalidTicket;
+    if (!hasCeiling) {
+        return;
+    }
+
+    EvaluateSafePosition(m_safeCheckHmdPos, m_safeCheckPlayerPos, m_safeCheckRequiredHeight, groundCheck, ceilingCheck);
+}
+
+void ClimbExitCorrector::CancelSafePositionCheck()
+{
+    Raycast::CancelDeferred(m_safeGroundTicket);
+    Raycast::CancelDeferred(m_safeCeilingTicket);
+    m_safeGroundTicket = Raycast::kInvalidTicket;
+    m_safeCeilingTicket = Raycast::kInvalidTicket;
+}
+
+void ClimbExitCorrector::EvaluateSafePosition(const RE::NiPoint3& hmdPos, const RE::NiPoint3& playerPos, float requiredHeight,
+    const RaycastResult& groundCheck, const RaycastResult& ceilingCheck)
+{
     float groundZ = playerPos.z;  // Default to current feet if no ground hit
     if (groundCheck.hit) {
         groundZ = groundCheck.hitPoint.z;
     }
 
-    // Cast ray UP from ground level to check ceiling clearance (only solid layers)
-    RE::NiPoint3 upDir = {0.0f, 0.0f, 1.0f};
-    RE::NiPoint3 ceilingCheckStart = {hmdPos.x, hmdPos.y, groundZ + 1.0f};
-    RaycastResult ceilingCheck = Raycast::CastRay(ceilingCheckStart, upDir, requiredHeight + 20.0f, LayerMasks::kSolid);
-
     float availableHeight;
     if (ceilingCheck.hit) {
-        availableHeight = ceilingCheck.distance;
+        availableHeight = ceilingCheck.hitPoint.z - groundZ;
     } else {
         availableHeight = requiredHeight + 100.0f;  // No ceiling = plenty of room
     }
@@ -409,8 +499,9 @@ void ClimbExitCorrector::UpdateSafePositionCheck()
 
 void ClimbExitCorrector::ClearSafePosition()
 {
+    CancelSafePositionCheck();
     m_hasLastKnownSafePosition = false;
-    // Set counter to threshold-1 so the FIRST UpdateSafePositionCheck() call runs immediately
+    // Set counter to threshold-1 so the FIRST UpdateSafePositionCheck() call schedules a check immediately
     // This ensures we capture a safe position right at climb start, not 50 frames later
     m_safePositionCheckCounter = SAFE_POSITION_CHECK_INTERVAL - 1;
     m_loggedHeightThisSession = false;  // Reset so we log height on next climb
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "RE/Skyrim.h"
+#include "FrameContext.h"
+#include "util/Raycast.h"
 
 // Corrects player position when exiting climb mode to prevent falling through geometry.
 // During climbing, the player's body can partially clip into surfaces. When releasing,
@@ -15,19 +17,20 @@ public:
     // Start correction process. Call when player releases all grips.
     // initialVelocity: the player's velocity at the moment of release (for direction)
     // Returns true if correction is needed and started, false if no correction needed.
-    bool StartCorrection(const RE::NiPoint3& initialVelocity);
+    bool StartCorrection(const FrameContext& frame, const RE::NiPoint3& initialVelocity);
 
     // Update each frame while correcting. Call from your main update loop.
-    // deltaTime: frame time in seconds
+    // Advances by frame.deltaTime
     // Returns true if still correcting, false when done.
-    bool Update(float deltaTime);
+    bool Update(const FrameContext& frame);
 
     // Cancel any in-progress correction (e.g., if player grabs again)
     void Cancel();
 
     // Call every frame during climbing or ballistic mode to track safe positions.
-    // Every 50 frames, checks if current position has enough vertical space to stand.
-    // If so, stores it as a fallback position for when normal correction fails.
+    // Every 50 frames, schedules a check (see QueryScheduler) of whether the current position
+    // has enough vertical space to stand. If so, stores it as a fallback position for when
+    // normal correction fails.
     void UpdateSafePositionCheck();
 
     // Clear the stored safe position (call when starting a new climb)
@@ -41,7 +44,7 @@ private:
 
     // Detect if correction is needed and calculate target position
     // Returns correction amount (0 if not needed)
-    float DetectCorrectionNeeded(RE::NiPoint3& outTargetPos);
+    float DetectCorrectionNeeded(const FrameContext& frame, RE::NiPoint3& outTargetPos);
 
     // Check available headroom at a given position
     // Returns actual headroom distance (large value if no ceiling)
@@ -50,7 +53,21 @@ private:
     // Try to find a horizontal escape route when vertical correction is blocked
     // searchDistance: how far to search horizontally (e.g., 50 or 100 units)
     // Returns true if valid escape found, sets outTargetPos to landing position
-    bool FindHorizontalEscape(float searchDistance, RE::NiPoint3& outTargetPos);
+    bool FindHorizontalEscape(const FrameContext& frame, float searchDistance, RE::NiPoint3& outTargetPos);
+
+    // Ground/ceiling check behind UpdateSafePositionCheck (runs from the query scheduler)
+    // Submits both rays as deferred queries; the result is applied by CollectSafePositionCheck
+    void RunSafePositionCheck(const FrameContext& frame);
+
+    // Apply the deferred safe position check once its rays have been resolved
+    void CollectSafePositionCheck();
+
+    // Store the position as safe if the ground/ceiling rays leave enough room to stand
+    void EvaluateSafePosition(const RE::NiPoint3& hmdPos, const RE::NiPoint3& playerPos, float requiredHeight,
+        const RaycastResult& groundCheck, const RaycastResult& ceilingCheck);
+
+    // Drop an in-flight deferred safe position check
+    void CancelSafePositionCheck();
 
     // Evaluate quadratic Bezier: B(t) = (1-t)²P0 + 2(1-t)tP1 + t²P2
     RE::NiPoint3 EvaluateBezier(float t) const;
@@ -68,6 +85,13 @@ private:
     int m_safePositionCheckCounter = 0;
     bool m_loggedHeightThisSession = false;  // Log player height once per session
 
+    // In-flight deferred safe position check (rays resolved in the physics pre-step)
+    Raycast::QueryTicket m_safeGroundTicket = Raycast::kInvalidTicket;
+    Raycast::QueryTicket m_safeCeilingTicket = Raycast::kInvalidTicket;
+    RE::NiPoint3 m_safeCheckHmdPos;      // Snapshot taken when the rays were submitted
+    RE::NiPoint3 m_safeCheckPlayerPos;
+    float m_safeCheckRequiredHeight = 0.0f;
+
     static constexpr int SAFE_POSITION_CHECK_INTERVAL = 50;  // Check every 50 frames
     static constexpr float MIN_STANDING_HEIGHT = 80.0f;       // Minimum fallback (crouched)
     static constexpr float HEADROOM_MARGIN = 10.0f;           // Extra clearance above head
@@ -9,6 +9,8 @@
 #include "EquipmentManager.h"
 #include "MenuChecker.h"
 #include "AudioManager.h"
+#include "HavokUtils.h"
+#include "SessionRecorder.h"
 #include "Config.h"
 #include <algorithm>
 
@@ -30,25 +32,22 @@
 
 #include "util/VRNodes.h"
 #include "util/Raycast.h"
+#include "util/HavokQueryBackend.h"
+#include "util/QueryScheduler.h"
+#include "util/TickRegistry.h"
 #include <spdlog/spdlog.h>
 #include <cmath>
 #include <cstring>
 
-// Layer filter for collision detection - returns true for solid world geometry
-// Used to prevent phasing through walls while climbing
-static bool IsSolidWorldLayer(RE::COL_LAYER layer)
+// The CommonLib-free climbing math (ClimbSmoother, VelocityHistory) works on PhysicsQuery::Vec3
+static PhysicsQuery::Vec3 ToVec3(const RE::NiPoint3& p)
 {
-    switch (layer) {
-        case RE::COL_LAYER::kStatic:
-        case RE::COL_LAYER::kAnimStatic:  // Moving platforms, gates, drawbridges
-        case RE::COL_LAYER::kTerrain:
-        case RE::COL_LAYER::kGround:
-        case RE::COL_LAYER::kTrees:
-        case RE::COL_LAYER::kProps:       // Larger props (furniture, etc.)
-            return true;
-        default:
-            return false;
-    }
+    return PhysicsQuery::Vec3{ p.x, p.y, p.z };
+}
+
+static RE::NiPoint3 ToNiPoint(const PhysicsQuery::Vec3& v)
+{
+    return RE::NiPoint3{ v.x, v.y, v.z };
 }
 
 // Fire a short haptic pulse when a hand successfully latches onto a surface.
@@ -174,6 +173,31 @@ static void TriggerLatchHaptic(bool isLeft)
     CallTriggerHapticPulse(openVR, isLeft ? kLeftHand : kRightHand, Config::options.latchHapticDuration);
 }
 
+// A point in a node's local frame and back - NiTransform applies world = rotate * (local * scale) + translate,
+// with NiMatrix3 row-major on column vectors, so the inverse uses the transposed rotation
+static RE::NiPoint3 WorldToLocal(const RE::NiTransform& transform, const RE::NiPoint3& point)
+{
+    const auto& m = transform.rotate.entry;
+    RE::NiPoint3 d = point - transform.translate;
+    float invScale = transform.scale != 0.0f ? 1.0f / transform.scale : 1.0f;
+    return {
+        (m[0][0] * d.x + m[1][0] * d.y + m[2][0] * d.z) * invScale,
+        (m[0][1] * d.x + m[1][1] * d.y + m[2][1] * d.z) * invScale,
+        (m[0][2] * d.x + m[1][2] * d.y + m[2][2] * d.z) * invScale
+    };
+}
+
+static RE::NiPoint3 LocalToWorld(const RE::NiTransform& transform, const RE::NiPoint3& point)
+{
+    const auto& m = transform.rotate.entry;
+    float s = transform.scale;
+    return {
+        (m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z) * s + transform.translate.x,
+        (m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z) * s + transform.translate.y,
+        (m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z) * s + transform.translate.z
+    };
+}
+
 ClimbManager* ClimbManager::GetSingleton()
 {
     static ClimbManager instance;
@@ -222,6 +246,22 @@ void ClimbManager::Initialize()
     // Initialize HIGGS compatibility manager
     HiggsCompatManager::GetSingleton()->Initialize();
 
+    // Deferred raycasts (Raycast::SubmitDeferred) are resolved in the physics pre-step
+    g_higgsInterface->AddPrePhysicsStepCallback(&ClimbManager::PrePhysicsStepCallback);
+
+    // Per-frame updates that only have work some of the time - each subscribes itself when it has some
+    TickRegistry::Register(TickRegistry::Tick::kBallisticFlight, [](const FrameContext& frame) {
+        ClimbManager::GetSingleton()->UpdateFlight(frame);
+    });
+    TickRegistry::Register(TickRegistry::Tick::kCriticalStrike, [](const FrameContext& frame) {
+        CriticalStrikeManager::GetSingleton()->Update(frame);
+    });
+    TickRegistry::Register(TickRegistry::Tick::kExitCorrection, [](const FrameContext& frame) {
+        ClimbExitCorrector::GetSingleton()->Update(frame);
+    });
+    TickRegistry::Register(TickRegistry::Tick::kHiggsRestore, [](const FrameContext&) {
+        HiggsCompatManager::GetSingleton()->Update();
+    });
 
     // Register for grip button input
     auto* inputMgr = InputManager::GetSingleton();
@@ -250,10 +290,10 @@ void ClimbManager::Shutdown()
     }
 
     // Stop any active climbing
-    if (m_leftGrabbing) {
+    if (IsHandGrabbing(true)) {
         StopClimb(true);
     }
-    if (m_rightGrabbing) {
+    if (IsHandGrabbing(false)) {
         StopClimb(false);
     }
 
@@ -261,8 +301,15 @@ void ClimbManager::Shutdown()
     if (inputMgr && m_gripCallbackId != InputManager::InvalidCallbackId) {
         inputMgr->RemoveVrButtonCallback(m_gripCallbackId);
         m_gripCallbackId = InputManager::InvalidCallbackId;
+
+        // Stop the input hook blocking grips on our behalf
+        uint64_t gripMask = vr::ButtonMaskFromId(vr::k_EButton_Grip);
+        inputMgr->SetConsumeOnPress(true, gripMask, false);
+        inputMgr->SetConsumeOnPress(false, gripMask, false);
     }
 
+    SessionRecorder::GetSingleton()->Stop();
+
     m_initialized = false;
     spdlog::info("ClimbManager shut down");
 }
@@ -278,11 +325,9 @@ void ClimbManager::OnMainThreadUpdate()
         return;
     }
 
-    // Hot reload config if enabled (throttled to every ~90 frames)
-    static uint32_t reloadCounter = 0;
-    if (Config::options.hotReloadEnabled && (++reloadCounter % 90 == 0)) {
-        Config::ReloadIfModified();
-    }
+    // New frame - drop raycast results cached during the previous frame
+    Raycast::BeginFrame();
+    instance->m_frameCount++;
 
     // Calculate deltaTime for this frame
     static auto lastTime = std::chrono::steady_clock::now();
@@ -293,59 +338,171 @@ void ClimbManager::OnMainThreadUpdate()
     // Clamp deltaTime
     if (deltaTime > 0.1f) deltaTime = 0.1f;
 
+    // Player, controller, world and VR node state for everything updated below
+    const FrameContext& frame = FrameContext::Begin(instance->m_frameCount, deltaTime);
+    SessionRecorder::GetSingleton()->BeginFrame(frame);
+
+    // Before grip edges are delivered - a grab records the predicted hand position as its anchor
+    instance->m_posePredictor.Update(frame);
+
+    // Where the head is relative to the player this frame, for the body sweep - the HMD node isn't
+    // updated when a physics step moves the player, so it can't be re-read between steps
+    if (frame.hasHmd && frame.player) {
+        instance->m_hmdOffset = frame.hmd.translate - frame.playerPosition;
+        instance->m_hasHmdOffset = true;
+    } else {
+        instance->m_hasHmdOffset = false;
+    }
+
+    // Grip edges queued by the OpenVR input thread - grab logic runs here rather than on the input thread
+    InputManager::GetSingleton()->ProcessButtonEvents();
+
+    // Hot reload config if enabled (throttled to every ~90 frames)
+    static uint32_t reloadCounter = 0;
+    if (Config::options.hotReloadEnabled && (++reloadCounter % 90 == 0)) {
+        Config::ReloadIfModified();
+    }
+
+    // Flight, exit correction, slow-mo and HIGGS restore - each runs only while it has work
+    TickRegistry::RunFrame(frame);
+
+    // Track safe positions for exit correction fallback (every 50 frames)
+    // Counted per frame here - physics-step and fixed-step climbing run UpdateClimbing several times a frame,
+    // and requests made from inside the pre-step would land after that step's ResolveDeferred
+    if (instance->IsClimbing()) {
+        ClimbExitCorrector::GetSingleton()->UpdateSafePositionCheck();
+    }
+
+    if (Config::options.physicsStepClimbing) {
+        // Climbing moves in the physics pre-step, but physics doesn't step while a menu
+        // has the game stopped - check for the menu release here
+        instance->m_hasSimPosition = false;
+        if (instance->IsClimbing()) {
+            instance->ReleaseGripsIfGameStopped();
+        }
+    } else if (Config::options.fixedStepRate > 0 && !Config::options.velocityClimbing) {
+        instance->UpdateClimbingFixedStep(deltaTime);
+    } else {
+        instance->m_hasSimPosition = false;
+        instance->UpdateClimbing(deltaTime);
+    }
+
+    // Keep setting InAir state while climbing (gravity disabled)
+    if (instance->m_gravityDisabled && frame.controller) {
+        frame.controller->wantState = RE::hkpCharacterStateType::kInAir;
+        // Mark as unsupported so physics doesn't apply ground movement
+        frame.controller->surfaceInfo.supportedState = RE::hkpSurfaceInfo::SupportedState::kUnsupported;
+    }
+
+    // Keep the input hook's grip consumption snapshot current
+    instance->UpdateGripConsumption(frame);
+
+    // Run deferred physics queries requested this frame (or earlier) within the frame budget
+    QueryScheduler::RunFrame();
+
+    float updateMicros = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - now).count();
+    SessionRecorder::GetSingleton()->EndFrame(frame, updateMicros);
+    FrameContext::End();
+}
+
+void ClimbManager::UpdateFlight(const FrameContext& frame)
+{
     // Update ballistic controller if in flight
+    // Havok integrates the flight itself, so at a fixed step rate the controller is advanced once per
+    // frame by the whole steps that are due - gravity is applied in the same quanta at any frame rate
     auto* ballistic = BallisticController::GetSingleton();
     if (ballistic->IsInFlight()) {
-        if (deltaTime > 0.0f) {
-            bool stillFlying = ballistic->Update(deltaTime);
+        float flightDeltaTime = frame.deltaTime;
+        if (Config::options.fixedStepRate > 0) {
+            int steps = m_flightStep.Advance(frame.deltaTime, Config::options.fixedStepRate, MAX_FIXED_STEPS_PER_FRAME);
+            flightDeltaTime = static_cast<float>(steps) * m_flightStep.GetStepTime();
+        }
+
+        if (flightDeltaTime > 0.0f) {
+            bool stillFlying = ballistic->Update(frame, flightDeltaTime);
 
             // If flight ended, check if it was due to auto-catch
             if (!stillFlying) {
                 auto catchResult = ballistic->GetAutoCatchResult();
                 if (catchResult != BallisticController::AutoCatchHand::kNone) {
-                    instance->HandleAutoCatch(static_cast<uint8_t>(catchResult));
+                    HandleAutoCatch(static_cast<uint8_t>(catchResult));
                     ballistic->ClearAutoCatchResult();
                 }
             }
         }
-    }
-    // Post-flight autocatch: check for catch opportunities during grace period
-    // This handles the case where player lands/bumps into something before grabbing
-    else if (ballistic->IsInAutoCatchWindow() && !instance->IsClimbing()) {
-        auto catchResult = ballistic->CheckAutoCatch();
-        if (catchResult != BallisticController::AutoCatchHand::kNone) {
-            instance->HandleAutoCatch(static_cast<uint8_t>(catchResult));
+    } else {
+        m_flightStep.Reset();  // Next flight starts from an empty accumulator
+
+        // Post-flight autocatch: check for catch opportunities during grace period
+        // This handles the case where player lands/bumps into something before grabbing
+        // Deferrable - the query scheduler runs it when the frame budget allows
+        if (ballistic->IsInAutoCatchWindow() && !IsClimbing()) {
+            QueryScheduler::Request(QueryScheduler::Task::kPostFlightAutoCatch, QueryScheduler::Priority::kNormal, [] {
+                auto* manager = ClimbManager::GetSingleton();
+                auto* controller = BallisticController::GetSingleton();
+                const auto* current = FrameContext::GetCurrent();
+
+                // State may have changed since the request (new flight, grab, window expired)
+                if (!current || controller->IsInFlight() || !controller->IsInAutoCatchWindow() || manager->IsClimbing()) {
+                    return;
+                }
+
+                auto catchResult = controller->CheckAutoCatch(*current);
+                if (catchResult != BallisticController::AutoCatchHand::kNone) {
+                    manager->HandleAutoCatch(static_cast<uint8_t>(catchResult));
+                }
+            });
         }
     }
 
-    // Update CriticalStrikeManager (must run even after landing to handle slow-mo timeout)
-    static uint32_t criticalFrameCount = 0;
-    CriticalStrikeManager::GetSingleton()->Update(++criticalFrameCount);
+    // Landed (or climbing again) and no auto-catch window left to watch - idle until the next flight
+    if (!ballistic->IsInFlight() && (!ballistic->IsInAutoCatchWindow() || IsClimbing())) {
+        m_flightStep.Reset();  // A flight that ended this frame hasn't been through the else branch yet
+        TickRegistry::Unsubscribe(TickRegistry::Tick::kBallisticFlight);
+    }
+}
 
-    // Update ClimbExitCorrector (must run even after landing to complete smooth correction)
-    ClimbExitCorrector::GetSingleton()->Update(deltaTime);
+void ClimbManager::PrePhysicsStepCallback(void* world)
+{
+    auto* instance = GetSingleton();
+    if (!instance->m_initialized) {
+        return;
+    }
 
-    // Update HiggsCompatManager (handles delayed restore of HIGGS settings)
-    HiggsCompatManager::GetSingleton()->Update();
+    // HIGGS calls this from bhkWorld::Update right before hkpWorld::stepDeltaTime, on the main
+    // thread between two frame updates - no synchronization with the update is needed
+    // The world may be locked for the step, so queries from here skip the world read lock
+    struct PhysicsStepScope {
+        PhysicsStepScope() { HavokQueryBackend::GetSingleton()->SetInPhysicsStep(true); }
+        ~PhysicsStepScope() { HavokQueryBackend::GetSingleton()->SetInPhysicsStep(false); }
+    } physicsStepScope;
 
-    instance->UpdateClimbing();
+    // Deferred queries look up the player's world themselves - the first step resolves them
+    Raycast::ResolveDeferred();
 
-    // Keep setting InAir state while climbing (gravity disabled)
-    if (instance->m_gravityDisabled) {
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (player) {
-            auto* controller = player->GetCharController();
-            if (controller) {
-                controller->wantState = RE::hkpCharacterStateType::kInAir;
-                // Mark as unsupported so physics doesn't apply ground movement
-                controller->surfaceInfo.supportedState = RE::hkpSurfaceInfo::SupportedState::kUnsupported;
-            }
-        }
+    if (!Config::options.physicsStepClimbing) {
+        return;
     }
+
+    // Climbing moves the player, so only the player's world's steps drive it
+    auto* player = RE::PlayerCharacter::GetSingleton();
+    if (!player || !player->parentCell || player->parentCell->GetbhkWorld() != world) {
+        return;
+    }
+
+    // Runs once per Havok step, so climbing follows the physics rate rather than the render rate,
+    // and moves the player from the latest hand poses right before they are simulated
+    float stepDeltaTime = *HavokUtils::g_deltaTime;
+    if (stepDeltaTime <= 0.0f) {
+        stepDeltaTime = 1.0f / 60.0f;  // Fallback to 60fps
+    }
+    instance->UpdateClimbing(stepDeltaTime);
 }
 
 bool ClimbManager::OnGripPressed(bool isLeft)
 {
+    SessionRecorder::GetSingleton()->RecordGripEdge(isLeft, true);
+
     // Don't process climbing inputs while in menus
     if (MenuChecker::IsGameStopped()) {
         return false;
@@ -362,10 +519,11 @@ bool ClimbManager::OnGripPressed(bool isLeft)
 
     // If either hand is already climbing, consume ALL grip inputs to prevent
     // the game from grabbing items while we're holding onto surfaces
-    bool eitherHandClimbing = m_leftGrabbing || m_rightGrabbing;
+    bool eitherHandClimbing = IsClimbing();
 
     // Check if there's a climbable surface near this hand
-    if (!ClimbSurfaceDetector::CanGrabSurface(isLeft)) {
+    RaycastResult contact{};
+    if (!FindGrabContact(isLeft, contact)) {
         // No surface nearby - don't start climbing with this hand
         // But still consume input if other hand is climbing
         return eitherHandClimbing;
@@ -384,14 +542,79 @@ bool ClimbManager::OnGripPressed(bool isLeft)
     }
 
     spdlog::info("ClimbManager: Starting climb ({}) - surface detected", isLeft ? "left" : "right");
-    StartClimb(isLeft);
+    StartClimb(isLeft, contact);
 
     // Consume input - we're climbing, don't let HIGGS grab objects
     return true;
 }
 
+bool ClimbManager::FindGrabContact(bool isLeft, RaycastResult& outContact)
+{
+    // Grip edges and auto-catch are handled in the frame update, so the frame is always current here
+    const auto* frame = FrameContext::GetCurrent();
+    if (!frame) {
+        return false;
+    }
+
+    bool canGrab = false;
+    if (!m_grabReadiness.TryGetCached(*frame, isLeft, canGrab)) {
+        canGrab = m_grabReadiness.Refresh(*frame, isLeft);
+    }
+    return canGrab && m_grabReadiness.GetCachedContact(isLeft, outContact);
+}
+
+void ClimbManager::UpdateGripConsumption(const FrameContext& frame)
+{
+    auto* inputMgr = InputManager::GetSingleton();
+    if (!inputMgr->IsInitialized()) {
+        return;
+    }
+
+    // Same checks OnGripPressed makes before it looks for a surface
+    bool gameStopped = MenuChecker::IsGameStopped();
+    bool canStartClimb = !gameStopped &&
+        (Config::options.climbingEnabled || frame.isBeastForm) &&
+        StaminaDrainManager::GetSingleton()->CanStartClimbing();
+
+    // Re-check the free hands whose cached answer may have changed (the hand or head moved past its margin),
+    // so a hand reaching for a wall is blocked before the press rather than from the poll after it
+    // Deferrable - a late result only delays the input block by a frame
+    bool refreshLeft = !m_leftGripHeld && m_grabReadiness.NeedsRefresh(frame, true);
+    bool refreshRight = !m_rightGripHeld && m_grabReadiness.NeedsRefresh(frame, false);
+    if (canStartClimb && (refreshLeft || refreshRight)) {
+        QueryScheduler::Request(QueryScheduler::Task::kGrabReadiness, QueryScheduler::Priority::kLow, [] {
+            auto* manager = ClimbManager::GetSingleton();
+            const auto* current = FrameContext::GetCurrent();
+            if (!current) {
+                return;
+            }
+            for (bool isLeft : { true, false }) {
+                bool gripHeld = isLeft ? manager->m_leftGripHeld : manager->m_rightGripHeld;
+                if (!gripHeld && manager->m_grabReadiness.NeedsRefresh(*current, isLeft)) {
+                    manager->m_grabReadiness.Refresh(*current, isLeft);
+                }
+            }
+        });
+    }
+
+    // While climbing every grip press is consumed so HIGGS doesn't grab objects, otherwise only presses of
+    // a hand whose grab check still holds and found a surface
+    // OnGripPressed makes the final call when the edge is delivered (checking synchronously if the answer
+    // went stale), and the hook applies it from the next controller poll while the grip is held
+    bool eitherHandClimbing = IsClimbing();
+    bool leftReady = false;
+    bool rightReady = false;
+    bool leftGrabReady = canStartClimb && !m_leftGripHeld && m_grabReadiness.TryGetCached(frame, true, leftReady) && leftReady;
+    bool rightGrabReady = canStartClimb && !m_rightGripHeld && m_grabReadiness.TryGetCached(frame, false, rightReady) && rightReady;
+    uint64_t gripMask = vr::ButtonMaskFromId(vr::k_EButton_Grip);
+    inputMgr->SetConsumeOnPress(true, gripMask, !gameStopped && (eitherHandClimbing || leftGrabReady));
+    inputMgr->SetConsumeOnPress(false, gripMask, !gameStopped && (eitherHandClimbing || rightGrabReady));
+}
+
 bool ClimbManager::OnGripReleased(bool isLeft)
 {
+    SessionRecorder::GetSingleton()->RecordGripEdge(isLeft, false);
+
     // Track grip state for auto-catch feature
     if (isLeft) {
         m_leftGripHeld = false;
@@ -400,10 +623,10 @@ bool ClimbManager::OnGripReleased(bool isLeft)
     }
 
     // Check if this hand was climbing
-    bool wasClimbing = isLeft ? m_leftGrabbing : m_rightGrabbing;
+    bool wasClimbing = IsHandGrabbing(isLeft);
 
     // Check if either hand is currently climbing (before we process this release)
-    bool eitherHandClimbing = m_leftGrabbing || m_rightGrabbing;
+    bool eitherHandClimbing = IsClimbing();
 
     if (wasClimbing) {
         spdlog::info("ClimbManager: Grip released ({})", isLeft ? "left" : "right");
@@ -415,10 +638,10 @@ bool ClimbManager::OnGripReleased(bool isLeft)
     return eitherHandClimbing;
 }
 
-void ClimbManager::StartClimb(bool isLeft)
+void ClimbManager::StartClimb(bool isLeft, const RaycastResult& contact)
 {
-    bool wasClimbing = m_leftGrabbing || m_rightGrabbing;
-    bool alreadyThisHandGrabbing = isLeft ? m_leftGrabbing : m_rightGrabbing;
+    bool wasClimbing = IsClimbing();
+    bool alreadyThisHandGrabbing = IsHandGrabbing(isLeft);
 
     // If we're currently in ballistic flight, abort it - player is grabbing mid-air
     auto* ballistic = BallisticController::GetSingleton();
@@ -462,59 +685,45 @@ void ClimbManager::StartClimb(bool isLeft)
     RE::NiPoint3 playerPos = player ? player->GetPosition() : RE::NiPoint3{0.0f, 0.0f, 0.0f};
     RE::NiPoint3 handOffset = handPos - playerPos;
 
-    if (isLeft) {
-        m_leftGrabbing = true;
-        m_leftGrabPoint = handPos;
-        m_leftPrevHandOffset = handOffset;  // Store offset, not world pos
-    } else {
-        m_rightGrabbing = true;
-        m_rightGrabPoint = handPos;
-        m_rightPrevHandOffset = handOffset;  // Store offset, not world pos
-    }
+    // The surface the hand latched onto - a moving one carries the player along (SampleAnchorMotion)
+    // The grab check already found it; following the object afterwards needs no queries
+    GrabState& grab = m_grabs[isLeft ? 0 : 1];
+    grab.grabbing = true;
+    SetGrabAnchor(isLeft, handPos, contact);
+    grab.prevHandOffset = handOffset;  // Store offset, not world pos
 
     // Initialize smoothing target to current player position
-    if (!m_hasTargetPosition) {
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (player) {
-            m_targetPosition = player->GetPosition();
-            m_hasTargetPosition = true;
-            m_lastUpdateTime = std::chrono::steady_clock::now();
-            m_hasLastUpdateTime = true;
-        }
+    if (!m_hasTargetPosition && player) {
+        ResetSmoothing();
+        m_targetPosition = player->GetPosition();
+        m_hasTargetPosition = true;
     }
 
     // Disable gravity and set to "in air" state when starting to climb
-    if (!m_gravityDisabled && (m_leftGrabbing || m_rightGrabbing)) {
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (player) {
-            auto* controller = player->GetCharController();
-            if (controller) {
-                m_savedGravity = controller->gravity;
-                controller->gravity = 0.0f;
-                m_gravityDisabled = true;
-
-                // Notify ClimbingDamageManager that we started climbing
-                ClimbingDamageManager::GetSingleton()->SetClimbingState(true);
-
-                // Disable HIGGS gravity gloves while climbing
-                HiggsCompatManager::GetSingleton()->DisableGravityGloves();
-
-                spdlog::info("ClimbManager: Gravity disabled (was {})", m_savedGravity);
-            }
+    if (!m_gravityDisabled && player) {
+        auto* controller = player->GetCharController();
+        if (controller) {
+            m_savedGravity = controller->gravity;
+            controller->gravity = 0.0f;
+            m_gravityDisabled = true;
+
+            // Notify ClimbingDamageManager that we started climbing
+            ClimbingDamageManager::GetSingleton()->SetClimbingState(true);
+
+            // Disable HIGGS gravity gloves while climbing
+            HiggsCompatManager::GetSingleton()->DisableGravityGloves();
+
+            spdlog::info("ClimbManager: Gravity disabled (was {})", m_savedGravity);
         }
     }
 }
 
 void ClimbManager::StopClimb(bool isLeft)
 {
-    if (isLeft) {
-        m_leftGrabbing = false;
-    } else {
-        m_rightGrabbing = false;
-    }
+    m_grabs[isLeft ? 0 : 1].grabbing = false;
 
     // When completely releasing (no hands grabbing), calculate and apply launch
-    if (!m_leftGrabbing && !m_rightGrabbing) {
+    if (!IsClimbing()) {
         spdlog::info("=== CLIMB MODE: EXIT ({} hand released) ===", isLeft ? "left" : "right");
 
         // Notify stamina manager that climbing stopped
@@ -526,8 +735,13 @@ void ClimbManager::StopClimb(bool isLeft)
         // Restore HIGGS gravity gloves
         HiggsCompatManager::GetSingleton()->RestoreGravityGloves();
 
+        // Latest controller velocity for the release flick
+        if (Config::options.trackedLaunchVelocityWeight > 0.0f) {
+            m_posePredictor.SampleTrackedVelocities();
+        }
+
         // Calculate launch velocity from movement history
-        RE::NiPoint3 launchVelocity = CalculateLaunchVelocity();
+        RE::NiPoint3 launchVelocity = CalculateLaunchVelocity(isLeft);
         float speed = std::sqrt(launchVelocity.x * launchVelocity.x +
                                 launchVelocity.y * launchVelocity.y +
                                 launchVelocity.z * launchVelocity.z);
@@ -535,15 +749,16 @@ void ClimbManager::StopClimb(bool isLeft)
         // Use BallisticController for both launch and fall scenarios
         // This ensures auto-catch works in both cases
         auto* ballistic = BallisticController::GetSingleton();
+        float savedGravity = m_savedGravity;
 
         if (speed >= Config::options.minLaunchSpeed) {
             // Fast release = launch with velocity
-            ballistic->Launch(launchVelocity, m_savedGravity);
+            ballistic->Launch(launchVelocity, savedGravity);
             spdlog::info("ClimbManager: Launching with velocity ({}, {}, {}), speed: {}, gravity: {}",
-                         launchVelocity.x, launchVelocity.y, launchVelocity.z, speed, m_savedGravity);
+                         launchVelocity.x, launchVelocity.y, launchVelocity.z, speed, savedGravity);
         } else {
             // Slow release = controlled fall (still has auto-catch protection)
-            ballistic->StartFall(m_savedGravity);
+            ballistic->StartFall(savedGravity);
             spdlog::info("ClimbManager: Starting fall (speed {} below threshold {})",
                          speed, Config::options.minLaunchSpeed);
         }
@@ -555,28 +770,22 @@ void ClimbManager::StopClimb(bool isLeft)
         m_gravityDisabled = false;
 
         // Clear velocity history
-        m_velocityHistory.clear();
+        m_velocityHistory.Clear();
 
         // Reset smoothing state
-        m_hasTargetPosition = false;
-        m_hasLastUpdateTime = false;
+        ResetSmoothing();
+        m_hasSimPosition = false;
+        m_unsampledTime = 0.0f;
     }
 }
 
-void ClimbManager::UpdateClimbing()
+void ClimbManager::UpdateClimbing(float deltaTime)
 {
-    if (!m_leftGrabbing && !m_rightGrabbing) {
+    if (!IsClimbing()) {
         return;  // Not climbing
     }
 
-    // Track safe positions for exit correction fallback (every 50 frames)
-    ClimbExitCorrector::GetSingleton()->UpdateSafePositionCheck();
-
-    // Force release grips if a game-stopping menu opened (dialogue, pause, etc.)
-    // Use NoLaunch version to avoid starting ballistic flight during menu
-    if (MenuChecker::IsGameStopped()) {
-        spdlog::info("ClimbManager: Menu opened while climbing - releasing all grips");
-        ForceReleaseAllGripsNoLaunch();
+    if (ReleaseGripsIfGameStopped()) {
         return;
     }
 
@@ -585,16 +794,6 @@ void ClimbManager::UpdateClimbing()
         return;
     }
 
-    // Calculate deltaTime
-    auto now = std::chrono::steady_clock::now();
-    float deltaTime = 0.0f;
-    if (m_hasLastUpdateTime) {
-        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastUpdateTime);
-        deltaTime = elapsed.count() / 1000000.0f;  // Convert to seconds
-    }
-    m_lastUpdateTime = now;
-    m_hasLastUpdateTime = true;
-
     // Validate deltaTime
     if (!std::isfinite(deltaTime) || deltaTime <= 0.0f) {
         return;  // Skip this frame
@@ -603,10 +802,10 @@ void ClimbManager::UpdateClimbing()
     // Update stamina drain - if out of stamina, force release
     if (!StaminaDrainManager::GetSingleton()->UpdateClimbingDrain(deltaTime)) {
         spdlog::info("ClimbManager: Out of stamina! Forcing release of all grips");
-        if (m_leftGrabbing) {
+        if (IsHandGrabbing(true)) {
             StopClimb(true);
         }
-        if (m_rightGrabbing) {
+        if (IsHandGrabbing(false)) {
             StopClimb(false);
         }
         return;  // Don't process climbing this frame
@@ -617,54 +816,226 @@ void ClimbManager::UpdateClimbing()
         deltaTime = MAX_DELTA;
     }
 
+    // With physics-step or fixed-step climbing several steps can run per rendered frame, but hand nodes only
+    // update once per frame - re-reading them after a step moved the player would count that movement as a pull.
+    // Sample the nodes on the first step of each frame. Physics steps run later in the frame than the nodes
+    // were posed, so each later one also pulls by the controllers' movement since the previous step (read
+    // straight from OpenVR); the next frame's node sample only counts what is left.
+    m_unsampledTime += deltaTime;
+    if (m_handSampleFrame == m_frameCount) {
+        RE::NiPoint3 stepDelta;
+        if (Config::options.physicsStepClimbing && SampleStepHandMovement(stepDelta)) {
+            if (Config::options.trackedLaunchVelocityWeight < 1.0f) {
+                m_velocityHistory.Push(ToVec3(stepDelta), m_unsampledTime, Config::options.maxVelocitySamples,
+                    Config::options.velocityHistoryTime, Config::options.velocityWeightExponent);
+            }
+            m_unsampledTime = 0.0f;
+            m_targetPosition += stepDelta;
+        }
+        ApplyClimbMovement(deltaTime);
+        return;
+    }
+    m_handSampleFrame = m_frameCount;
+    float sampleTime = m_unsampledTime;  // Time covered by this frame's hand movement
+    m_unsampledTime = 0.0f;
+
+    // Hand offsets are taken before a moving object carries the player - the hand nodes follow next frame
+    RE::NiPoint3 playerPos = player->GetPosition();
+    RE::NiPoint3 totalDelta = SampleHandMovement(playerPos);
+    if (Config::options.physicsStepClimbing) {
+        m_posePredictor.SampleStepMovement();  // Later steps measure from here
+    }
+
+    // Carried by a moving object the player holds - applied rigidly to the player and target, so it isn't
+    // smoothed (and doesn't count toward launches)
+    RE::NiPoint3 anchorMotion = SampleAnchorMotion();
+    if (anchorMotion.x != 0.0f || anchorMotion.y != 0.0f || anchorMotion.z != 0.0f) {
+        m_targetPosition += anchorMotion;
+        if (m_hasSimPosition) {
+            m_simPosition += anchorMotion;
+            m_prevSimPosition += anchorMotion;
+        } else {
+            player->SetPosition(playerPos + anchorMotion, true);
+        }
+    }
+
+    // Track velocity for launch mechanics
+    // Store the movement delta and time, trimming to the newest maxVelocitySamples within velocityHistoryTime
+    // The sample's speed weight is folded into the running launch estimate here, off the release frame
+    // Nothing reads the history when launches come from the controller velocity alone
+    if (Config::options.trackedLaunchVelocityWeight < 1.0f) {
+        m_velocityHistory.Push(ToVec3(totalDelta), sampleTime, Config::options.maxVelocitySamples, Config::options.velocityHistoryTime,
+            Config::options.velocityWeightExponent);
+    }
+
+    // Accumulate delta into target position
+    m_targetPosition += totalDelta;
+
+    // Apply smoothed movement toward target
+    ApplyClimbMovement(deltaTime);
+}
+
+bool ClimbManager::ReleaseGripsIfGameStopped()
+{
+    // Force release grips if a game-stopping menu opened (dialogue, pause, etc.)
+    // Use NoLaunch version to avoid starting ballistic flight during menu
+    if (!MenuChecker::IsGameStopped()) {
+        return false;
+    }
+
+    spdlog::info("ClimbManager: Menu opened while climbing - releasing all grips");
+    ForceReleaseAllGripsNoLaunch();
+    return true;
+}
+
+void ClimbManager::UpdateClimbingFixedStep(float frameDeltaTime)
+{
+    auto* player = RE::PlayerCharacter::GetSingleton();
+    if (!IsClimbing() || !player) {
+        m_fixedStep.Reset();
+        m_hasSimPosition = false;
+        return;
+    }
+
     RE::NiPoint3 playerPos = player->GetPosition();
+    if (!m_hasSimPosition) {
+        // Climb just started - simulate from where the player is
+        m_simPosition = playerPos;
+        m_prevSimPosition = playerPos;
+        m_hasSimPosition = true;
+        m_fixedStep.Reset();
+    } else {
+        // Carry over anything else that moved the player since the last displayed position
+        // (character controller push-out etc.), same as per-frame climbing reading GetPosition
+        RE::NiPoint3 externalOffset = playerPos - m_displayedPosition;
+        m_simPosition += externalOffset;
+        m_prevSimPosition += externalOffset;
+    }
+
+    int steps = m_fixedStep.Advance(frameDeltaTime, Config::options.fixedStepRate, MAX_FIXED_STEPS_PER_FRAME);
+    for (int i = 0; i < steps; ++i) {
+        m_prevSimPosition = m_simPosition;
+        UpdateClimbing(m_fixedStep.GetStepTime());
+
+        // Released, out of stamina or a menu opened - StopClimb cleared the simulated position
+        if (!m_hasSimPosition) {
+            return;
+        }
+    }
+
+    // Display the player between the last two simulated positions
+    float alpha = m_fixedStep.GetAlpha();
+    RE::NiPoint3 displayPos = m_prevSimPosition + (m_simPosition - m_prevSimPosition) * alpha;
+    player->SetPosition(displayPos, true);
+    m_displayedPosition = displayPos;
+}
+
+void ClimbManager::ApplyClimbMovement(float deltaTime)
+{
+    auto* player = RE::PlayerCharacter::GetSingleton();
+    if (!player) {
+        return;
+    }
+
+    auto* controller = player->GetCharController();
+    if (!controller) {
+        return;
+    }
+
+
+    // Get current player position (the simulated one when stepping at a fixed rate - the displayed
+    // position is interpolated between steps)
+    RE::NiPoint3 currentPos = m_hasSimPosition ? m_simPosition : player->GetPosition();
+
+    // Velocity mode: Havok's character proxy moves the player and resolves contacts itself
+    // (fixed-step climbing keeps teleporting - its positions are interpolated for display)
+    bool velocityMode = Config::options.velocityClimbing && !m_hasSimPosition;
+    bool sweepBody = !velocityMode || Config::options.velocityClimbingSweep;
+
+    if (!sweepBody) {
+        // Nothing clamps the target to walls the proxy is held back by - keep it within reach so
+        // pulling the other way responds right away instead of first unwinding the overshoot
+        constexpr float MAX_TARGET_LEAD = 24.0f;
+        RE::NiPoint3 toTarget = m_targetPosition - currentPos;
+        float targetDistance = std::sqrt(toTarget.x * toTarget.x + toTarget.y * toTarget.y + toTarget.z * toTarget.z);
+        if (targetDistance > MAX_TARGET_LEAD) {
+            m_targetPosition = currentPos + toTarget * (MAX_TARGET_LEAD / targetDistance);
+        }
+    } else {
+        // Wall/floor collision - clamp the TARGET position directly, so smoothing handles the transition
+        CapsuleSweepRequest sweep;
+        if (BuildBodySweep(currentPos, sweep)) {
+            RAYCAST_QUERY_SITE(kClimbSweep);
+            RaycastResult contact = Raycast::SweepCapsule(sweep.segmentStart, sweep.segmentEnd, sweep.radius, sweep.direction,
+                sweep.maxDistance, sweep.layerMask, sweep.outputs);
+            ResolveBodySweep(currentPos, sweep, contact);
+        }
+    }
+
+    RE::NiPoint3 newPos = SmoothTowardTarget(currentPos, deltaTime);
+
+    if (velocityMode) {
+        // Velocity that covers this step's smoothed move - the proxy integrates it over the physics steps
+        // that follow, so the player moves continuously and slides along what it touches
+        RE::NiPoint3 velocity = (newPos - currentPos) * (1.0f / deltaTime);
+        float havokScale = RE::bhkWorld::GetWorldScale();
+
+        RE::hkVector4 hkVelocity;
+        hkVelocity.quad.m128_f32[0] = velocity.x * havokScale;
+        hkVelocity.quad.m128_f32[1] = velocity.y * havokScale;
+        hkVelocity.quad.m128_f32[2] = velocity.z * havokScale;
+        hkVelocity.quad.m128_f32[3] = 0.0f;
+        controller->SetLinearVelocityImpl(hkVelocity);
+        return;
+    }
+
+    // Zero out velocity to prevent physics drift
+    RE::hkVector4 zero;
+    zero.quad.m128_f32[0] = 0.0f;
+    zero.quad.m128_f32[1] = 0.0f;
+    zero.quad.m128_f32[2] = 0.0f;
+    zero.quad.m128_f32[3] = 0.0f;
+    controller->SetLinearVelocityImpl(zero);
+
+    // Apply new position (fixed-step climbing displays it once the frame's steps are done)
+    if (m_hasSimPosition) {
+        m_simPosition = newPos;
+        return;
+    }
+    player->SetPosition(newPos, true);
+}
+
+RE::NiPoint3 ClimbManager::SampleHandMovement(const RE::NiPoint3& playerPos)
+{
     RE::NiPoint3 totalDelta{0.0f, 0.0f, 0.0f};
     int grabCount = 0;
 
-    // Calculate movement delta from left hand using OFFSETS from player
+    // Calculate movement delta from each grabbing hand using OFFSETS from player
     // This ensures player movement doesn't affect the delta calculation
-    if (m_leftGrabbing) {
-        RE::NiPoint3 currentHandPos = GetHandWorldPosition(true);
-        RE::NiPoint3 currentHandOffset = currentHandPos - playerPos;
+    for (bool isLeft : { true, false }) {
+        if (!IsHandGrabbing(isLeft)) {
+            continue;
+        }
+
+        RE::NiPoint3& prevHandOffset = m_grabs[isLeft ? 0 : 1].prevHandOffset;
+        RE::NiPoint3 currentHandOffset = GetHandWorldPosition(isLeft) - playerPos;
         // Delta is how much the hand offset changed
         // Player should move in the OPPOSITE direction (pulling yourself up)
-        RE::NiPoint3 handMovement = currentHandOffset - m_leftPrevHandOffset;
+        RE::NiPoint3 handMovement = currentHandOffset - prevHandOffset;
 
         // Debug: log large offset changes (potential mod interference)
         float offsetChange = std::sqrt(handMovement.x * handMovement.x + handMovement.y * handMovement.y + handMovement.z * handMovement.z);
         if (offsetChange > 10.0f) {
-            spdlog::warn("ClimbManager: Large L hand offset change! movement=({:.1f},{:.1f},{:.1f}) mag={:.1f}, "
+            spdlog::warn("ClimbManager: Large {} hand offset change! movement=({:.1f},{:.1f},{:.1f}) mag={:.1f}, "
                 "prevOffset=({:.1f},{:.1f},{:.1f}), currOffset=({:.1f},{:.1f},{:.1f}), playerPos=({:.1f},{:.1f},{:.1f})",
-                handMovement.x, handMovement.y, handMovement.z, offsetChange,
-                m_leftPrevHandOffset.x, m_leftPrevHandOffset.y, m_leftPrevHandOffset.z,
+                isLeft ? "L" : "R", handMovement.x, handMovement.y, handMovement.z, offsetChange,
+                prevHandOffset.x, prevHandOffset.y, prevHandOffset.z,
                 currentHandOffset.x, currentHandOffset.y, currentHandOffset.z,
                 playerPos.x, playerPos.y, playerPos.z);
         }
 
         totalDelta = totalDelta - handMovement;  // Negative = pull toward grab point
-        m_leftPrevHandOffset = currentHandOffset;
-        grabCount++;
-    }
-
-    // Calculate movement delta from right hand using OFFSETS from player
-    if (m_rightGrabbing) {
-        RE::NiPoint3 currentHandPos = GetHandWorldPosition(false);
-        RE::NiPoint3 currentHandOffset = currentHandPos - playerPos;
-        RE::NiPoint3 handMovement = currentHandOffset - m_rightPrevHandOffset;
-
-        // Debug: log large offset changes (potential mod interference)
-        float offsetChange = std::sqrt(handMovement.x * handMovement.x + handMovement.y * handMovement.y + handMovement.z * handMovement.z);
-        if (offsetChange > 10.0f) {
-            spdlog::warn("ClimbManager: Large R hand offset change! movement=({:.1f},{:.1f},{:.1f}) mag={:.1f}, "
-                "prevOffset=({:.1f},{:.1f},{:.1f}), currOffset=({:.1f},{:.1f},{:.1f}), playerPos=({:.1f},{:.1f},{:.1f})",
-                handMovement.x, handMovement.y, handMovement.z, offsetChange,
-                m_rightPrevHandOffset.x, m_rightPrevHandOffset.y, m_rightPrevHandOffset.z,
-                currentHandOffset.x, currentHandOffset.y, currentHandOffset.z,
-                playerPos.x, playerPos.y, playerPos.z);
-        }
-
-        totalDelta = totalDelta - handMovement;
-        m_rightPrevHandOffset = currentHandOffset;
+        prevHandOffset = currentHandOffset;
         grabCount++;
     }
 
@@ -675,158 +1046,176 @@ void ClimbManager::UpdateClimbing()
         totalDelta.z /= static_cast<float>(grabCount);
     }
 
-    // Track velocity for launch mechanics
-    // Store the movement delta and time for velocity calculation
-    VelocitySample sample;
-    sample.delta = totalDelta;
-    sample.deltaTime = deltaTime;
-    m_velocityHistory.push_back(sample);
-
-    // Debug logging: log sample details when delta is significant
-    float deltaMag = std::sqrt(totalDelta.x * totalDelta.x + totalDelta.y * totalDelta.y + totalDelta.z * totalDelta.z);
-    float instantVel = deltaTime > 0.0f ? deltaMag / deltaTime : 0.0f;
-
-    // Trim old samples (keep only recent ones within time window)
-    float totalTime = 0.0f;
-    while (m_velocityHistory.size() > static_cast<size_t>(Config::options.maxVelocitySamples)) {
-        m_velocityHistory.pop_front();
-    }
-    // Also trim by time - remove samples older than velocityHistoryTime
-    while (!m_velocityHistory.empty()) {
-        totalTime = 0.0f;
-        for (const auto& s : m_velocityHistory) {
-            totalTime += s.deltaTime;
-        }
-        if (totalTime > Config::options.velocityHistoryTime && m_velocityHistory.size() > 1) {
-            m_velocityHistory.pop_front();
-        } else {
-            break;
+    return totalDelta;
+}
+
+bool ClimbManager::SampleStepHandMovement(RE::NiPoint3& outDelta)
+{
+    m_posePredictor.SampleStepMovement();
+
+    RE::NiPoint3 totalDelta{0.0f, 0.0f, 0.0f};
+    int grabCount = 0;
+    for (bool isLeft : { true, false }) {
+        RE::NiPoint3 handMovement;
+        if (!IsHandGrabbing(isLeft) || !m_posePredictor.GetStepMovement(isLeft, handMovement)) {
+            continue;
         }
-    }
 
-    // Accumulate delta into target position
-    m_targetPosition.x += totalDelta.x;
-    m_targetPosition.y += totalDelta.y;
-    m_targetPosition.z += totalDelta.z;
+        // The hand node catches up next frame - move the stored offset with it so that isn't a second pull
+        m_grabs[isLeft ? 0 : 1].prevHandOffset += handMovement;
+        totalDelta = totalDelta - handMovement;
+        grabCount++;
+    }
 
-    // Apply smoothed movement toward target
-    ApplyClimbMovement(deltaTime);
+    if (grabCount == 0) {
+        return false;
+    }
+    outDelta = totalDelta * (1.0f / static_cast<float>(grabCount));
+    return true;
 }
 
-void ClimbManager::ApplyClimbMovement(float deltaTime)
+void ClimbManager::SetGrabAnchor(bool isLeft, const RE::NiPoint3& handPos, const RaycastResult& contact)
 {
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
+    GrabState& grab = m_grabs[isLeft ? 0 : 1];
+    grab.grabPoint = handPos;
+    grab.anchorRef.reset();
+
+    // Gates, drawbridges, lifts - the rest of the climbable layers don't move
+    if (!contact.hit || contact.collisionLayer != RE::COL_LAYER::kAnimStatic || !contact.hitRef) {
         return;
     }
 
-    auto* controller = player->GetCharController();
-    if (!controller) {
+    RE::NiAVObject* root = contact.hitRef->Get3D();
+    if (!root) {
         return;
     }
 
-    // Get current player position
-    RE::NiPoint3 currentPos = player->GetPosition();
+    grab.anchorRef = contact.hitRef->GetHandle();
+    grab.anchorLocal = WorldToLocal(root->world, handPos);
+    spdlog::debug("ClimbManager: {} hand anchored to moving object {:08X}", isLeft ? "Left" : "Right",
+        contact.hitRef->GetFormID());
+}
 
-    // Wall collision detection - clamp TARGET position directly so smoothing handles the transition
-    // Check from HMD toward target position (not just this frame's movement)
-    RE::NiAVObject* hmdNode = VRNodes::GetHMD();
-    RE::NiPoint3 hmdPos = hmdNode ? hmdNode->world.translate : currentPos;
+RE::NiPoint3 ClimbManager::SampleAnchorMotion()
+{
+    RE::NiPoint3 totalMotion{0.0f, 0.0f, 0.0f};
+    int anchorCount = 0;
 
-    // Vector from current position to target
-    RE::NiPoint3 toTarget = m_targetPosition - currentPos;
-    float targetDistance = std::sqrt(toTarget.x * toTarget.x + toTarget.y * toTarget.y + toTarget.z * toTarget.z);
+    for (bool isLeft : { true, false }) {
+        GrabState& grab = m_grabs[isLeft ? 0 : 1];
+        if (!IsHandGrabbing(isLeft) || !grab.anchorRef) {
+            continue;
+        }
 
-    if (targetDistance > 0.001f) {
-        // Normalize direction to target
-        RE::NiPoint3 targetDir = {
-            toTarget.x / targetDistance,
-            toTarget.y / targetDistance,
-            toTarget.z / targetDistance
-        };
-
-        // Calculate directional buffer based on HMD forward
-        // Forward needs larger buffer (16.0) to prevent near-plane culling
-        // Other directions can use smaller buffer (8.0)
-        constexpr float BUFFER_FORWARD = 16.0f;
-        constexpr float BUFFER_OTHER = 14.0f;
-        float wallBuffer = BUFFER_OTHER;
-
-        if (hmdNode) {
-            // Get HMD forward vector (Y-axis in Skyrim's coordinate system)
-            const auto& rotation = hmdNode->world.rotate;
-            RE::NiPoint3 hmdForward = {
-                rotation.entry[0][1],
-                rotation.entry[1][1],
-                rotation.entry[2][1]
-            };
-
-            // Dot product: 1.0 = moving forward, -1.0 = moving backward, 0 = sideways
-            float forwardDot = targetDir.x * hmdForward.x + targetDir.y * hmdForward.y + targetDir.z * hmdForward.z;
-
-            // Scale buffer: BUFFER_OTHER for backward/sideways, BUFFER_FORWARD for forward
-            float forwardAmount = (std::max)(0.0f, forwardDot);
-            wallBuffer = BUFFER_OTHER + forwardAmount * (BUFFER_FORWARD - BUFFER_OTHER);
+        // Object unloaded or disabled - the grab stays where it is, like on a static surface
+        auto ref = grab.anchorRef.get();
+        RE::NiAVObject* root = ref ? ref->Get3D() : nullptr;
+        if (!root) {
+            grab.anchorRef.reset();
+            continue;
         }
 
-        // Cast ray from HMD toward target position
-        float allowedDist = Raycast::GetAllowedDistance(hmdPos, targetDir, targetDistance, wallBuffer, IsSolidWorldLayer);
+        RE::NiPoint3 anchorWorld = LocalToWorld(root->world, grab.anchorLocal);
+        totalMotion += anchorWorld - grab.grabPoint;
+        grab.grabPoint = anchorWorld;
+        anchorCount++;
+    }
 
-        if (allowedDist < targetDistance) {
-            // Wall detected - clamp target position directly (no pressure buildup)
-            m_targetPosition.x = currentPos.x + targetDir.x * allowedDist;
-            m_targetPosition.y = currentPos.y + targetDir.y * allowedDist;
-            m_targetPosition.z = currentPos.z + targetDir.z * allowedDist;
-        }
+    // Average if both hands hold moving objects
+    if (anchorCount > 1) {
+        totalMotion = totalMotion * (1.0f / static_cast<float>(anchorCount));
+    }
+
+    return totalMotion;
+}
+
+bool ClimbManager::BuildBodySweep(const RE::NiPoint3& currentPos, CapsuleSweepRequest& outSweep) const
+{
+    RE::NiPoint3 toTarget = m_targetPosition - currentPos;
+    float targetDistance = std::sqrt(toTarget.x * toTarget.x + toTarget.y * toTarget.y + toTarget.z * toTarget.z);
+    if (targetDistance <= 0.001f) {
+        return false;
     }
 
-    // Exponential smoothing - smoothFactor = 1 - exp(-speed * deltaTime)
-    float smoothFactor = 1.0f - std::exp(-Config::options.smoothingSpeed * deltaTime);
+    // Body radius doubles as the wall buffer around the head (keeps walls out of the near plane)
+    constexpr float BODY_RADIUS = 16.0f;
+
+    // Lips lower than this above the feet are left to the character controller to step over, so a mantle
+    // isn't stopped by the ledge edge it is pulling the body over
+    constexpr float STEP_HEIGHT = 32.0f;
 
-    // Clamp to valid range [0, 1]
-    if (smoothFactor < 0.0f) smoothFactor = 0.0f;
-    if (smoothFactor > 1.0f) smoothFactor = 1.0f;
+    // The body is a capsule from above step height up to the head - from the feet when moving down,
+    // so climbing down still stops at the floor
+    // Roomscale: the head (and the body under it) can be away from the player origin
+    RE::NiPoint3 hmdOffset = m_hasHmdOffset ? m_hmdOffset : RE::NiPoint3{ 0.0f, 0.0f, BODY_RADIUS };
+    RE::NiPoint3 bodyTop = currentPos + hmdOffset;
 
-    // Smooth toward (possibly clamped) target - single smoothing handles everything
-    RE::NiPoint3 newPos;
-    newPos.x = currentPos.x + (m_targetPosition.x - currentPos.x) * smoothFactor;
-    newPos.y = currentPos.y + (m_targetPosition.y - currentPos.y) * smoothFactor;
-    newPos.z = currentPos.z + (m_targetPosition.z - currentPos.z) * smoothFactor;
+    RE::NiPoint3 direction = toTarget * (1.0f / targetDistance);
+    float bottom = currentPos.z + BODY_RADIUS + (direction.z < 0.0f ? 0.0f : STEP_HEIGHT);
 
-    // Floor detection - prevent climbing down into ground
-    // Cast ray from player position + offset, downward for 5 units
-    // If we hit ground and we're trying to move down, block the downward component
-    if (newPos.z < currentPos.z) {  // Only check if moving downward
-        constexpr float FLOOR_CHECK_HEIGHT = 80.0f;  // Start ray this high above player origin
-        constexpr float FLOOR_CHECK_DISTANCE = 5.0f; // Check this far down
+    outSweep.segmentStart = { bodyTop.x, bodyTop.y, (std::min)(bottom, bodyTop.z) };
+    outSweep.segmentEnd = bodyTop;
+    outSweep.radius = BODY_RADIUS;
+    outSweep.direction = direction;
+    outSweep.maxDistance = targetDistance;
+    outSweep.layerMask = LayerMasks::kSolid;
+    outSweep.outputs = RaycastOutputs::kNormal;
+    return true;
+}
+
+void ClimbManager::ResolveBodySweep(const RE::NiPoint3& currentPos, const CapsuleSweepRequest& sweep, const RaycastResult& contact)
+{
+    if (!contact.hit) {
+        return;
+    }
 
-        RE::NiPoint3 floorCheckOrigin = currentPos;
-        floorCheckOrigin.z += FLOOR_CHECK_HEIGHT;
-        RE::NiPoint3 downDir = { 0.0f, 0.0f, -1.0f };
+    constexpr float CONTACT_SKIN = 1.0f;  // Stop this far short of the contact
 
-        float floorDist = Raycast::GetAllowedDistance(floorCheckOrigin, downDir, FLOOR_CHECK_DISTANCE, 0.0f, IsSolidWorldLayer);
+    // Move up to the contact, then slide the rest of the way along the surface
+    // (drop the part of the remaining move that goes into it)
+    float allowedDist = (std::max)(contact.distance - CONTACT_SKIN, 0.0f);
+    RE::NiPoint3 contactPos = currentPos + sweep.direction * allowedDist;
+    RE::NiPoint3 remaining = m_targetPosition - contactPos;
 
-        if (floorDist < FLOOR_CHECK_DISTANCE) {
-            // Ground detected below - prevent further downward movement
-            newPos.z = currentPos.z;
-            m_targetPosition.z = currentPos.z;
+    const RE::NiPoint3& normal = contact.hitNormal;
+    float normalLengthSq = normal.x * normal.x + normal.y * normal.y + normal.z * normal.z;
+    if (normalLengthSq > 0.25f) {
+        float intoSurface = (remaining.x * normal.x + remaining.y * normal.y + remaining.z * normal.z) / normalLengthSq;
+        if (intoSurface < 0.0f) {
+            remaining = remaining - normal * intoSurface;
         }
+        m_targetPosition = contactPos + remaining;
+    } else {
+        m_targetPosition = contactPos;  // No usable normal - just stop at the contact
     }
+}
 
-    // Zero out velocity to prevent physics drift
-    RE::hkVector4 zero;
-    zero.quad.m128_f32[0] = 0.0f;
-    zero.quad.m128_f32[1] = 0.0f;
-    zero.quad.m128_f32[2] = 0.0f;
-    zero.quad.m128_f32[3] = 0.0f;
-    controller->SetLinearVelocityImpl(zero);
+void ClimbManager::ResetSmoothing()
+{
+    m_hasTargetPosition = false;
+    m_smoother.Reset();
+}
 
-    // Apply new position
-    player->SetPosition(newPos, true);
+RE::NiPoint3 ClimbManager::SmoothTowardTarget(const RE::NiPoint3& currentPos, float deltaTime)
+{
+    ClimbSmoother::Settings settings;
+    settings.mode = Config::options.smoothingMode;
+    settings.speed = Config::options.smoothingSpeed;
+    settings.oneEuroMinCutoff = Config::options.oneEuroMinCutoff;
+    settings.oneEuroBeta = Config::options.oneEuroBeta;
+    settings.oneEuroDerivativeCutoff = Config::options.oneEuroDerivativeCutoff;
+
+    return ToNiPoint(m_smoother.Step(ToVec3(currentPos), ToVec3(m_targetPosition), deltaTime, settings));
 }
 
 RE::NiPoint3 ClimbManager::GetHandWorldPosition(bool isLeft) const
 {
+    // Grab anchors and pull deltas both read this, so either both use the prediction or neither does
+    RE::NiPoint3 predictedPos;
+    if (m_posePredictor.GetPredictedPosition(isLeft, predictedPos)) {
+        return predictedPos;
+    }
+
     RE::NiAVObject* handNode = isLeft ? VRNodes::GetLeftHand() : VRNodes::GetRightHand();
 
     if (handNode) {
@@ -847,131 +1236,57 @@ bool ClimbManager::IsPlayerInBeastForm()
     return EquipmentManager::GetSingleton()->IsInBeastForm();
 }
 
-RE::NiPoint3 ClimbManager::CalculateLaunchVelocity() const
+RE::NiPoint3 ClimbManager::CalculateLaunchVelocity(bool releasedLeft) const
 {
-    if (m_velocityHistory.empty()) {
-        return RE::NiPoint3{0.0f, 0.0f, 0.0f};
+    // OpenVR's controller velocity of the hand that let go - IMU-fused, so it is the release flick itself
+    // rather than an average over velocityHistoryTime. The player moves opposite to the hand.
+    float trackedWeight = std::clamp(Config::options.trackedLaunchVelocityWeight, 0.0f, 1.0f);
+    RE::NiPoint3 trackedVelocity;
+    bool hasTracked = trackedWeight > 0.0f && m_posePredictor.GetTrackedVelocity(releasedLeft, trackedVelocity);
+    if (hasTracked) {
+        trackedVelocity = trackedVelocity * -1.0f;
     }
 
-    // Debug: dump all velocity samples at launch time
-    int sampleIdx = 0;
-
-
     // Velocity-weighted average: faster hand movements have more influence on final direction
     // Weight = pow(speed, exponent) where exponent is configurable
     // This makes the "flick" at release dominate over slow positioning movements
+    // Samples are weighted as they are pushed in UpdateClimbing, so release only reads the running totals
     float exponent = Config::options.velocityWeightExponent;
     float filterAngle = Config::options.launchDirectionFilter;
     bool filterEnabled = filterAngle > 0.0f && filterAngle < 180.0f;
 
     // Convert angle threshold to cosine (for dot product comparison)
     // cos(60°) ≈ 0.5, cos(90°) = 0, cos(45°) ≈ 0.707
+    // Samples outside the cone around the dominant direction are rejected as outliers
     constexpr float DEG_TO_RAD = 3.14159265f / 180.0f;
     float cosThreshold = filterEnabled ? std::cos(filterAngle * DEG_TO_RAD) : -1.0f;
 
-    // ===== FIRST PASS: Calculate velocity-weighted dominant direction =====
-    RE::NiPoint3 weightedDir{0.0f, 0.0f, 0.0f};
-    float dirWeight = 0.0f;
-
-    for (const auto& sample : m_velocityHistory) {
-        if (sample.deltaTime <= 0.0f) continue;
-
-        // Calculate instantaneous velocity
-        RE::NiPoint3 sampleVel;
-        sampleVel.x = sample.delta.x / sample.deltaTime;
-        sampleVel.y = sample.delta.y / sample.deltaTime;
-        sampleVel.z = sample.delta.z / sample.deltaTime;
-
-        float speed = std::sqrt(sampleVel.x * sampleVel.x +
-                                sampleVel.y * sampleVel.y +
-                                sampleVel.z * sampleVel.z);
-
-        if (speed < 0.001f) continue;  // Skip near-zero velocity
-
-        // Normalize direction and weight by speed^exponent
-        float weight = std::pow(speed, exponent);
-        weightedDir.x += (sampleVel.x / speed) * weight;
-        weightedDir.y += (sampleVel.y / speed) * weight;
-        weightedDir.z += (sampleVel.z / speed) * weight;
-        dirWeight += weight;
-    }
-
-    // Normalize to get dominant direction
-    RE::NiPoint3 dominantDir{0.0f, 0.0f, 0.0f};
-    if (dirWeight > 0.0f) {
-        float dirMag = std::sqrt(weightedDir.x * weightedDir.x +
-                                 weightedDir.y * weightedDir.y +
-                                 weightedDir.z * weightedDir.z);
-        if (dirMag > 0.001f) {
-            dominantDir.x = weightedDir.x / dirMag;
-            dominantDir.y = weightedDir.y / dirMag;
-            dominantDir.z = weightedDir.z / dirMag;
-        }
-    }
-
-    // ===== SECOND PASS: Accumulate velocity, rejecting outliers =====
-    RE::NiPoint3 weightedVelocity{0.0f, 0.0f, 0.0f};
-    float totalWeight = 0.0f;
-    int rejectedSamples = 0;
-
-    for (const auto& sample : m_velocityHistory) {
-        if (sample.deltaTime <= 0.0f) continue;
-
-        // Calculate instantaneous velocity
-        RE::NiPoint3 sampleVel;
-        sampleVel.x = sample.delta.x / sample.deltaTime;
-        sampleVel.y = sample.delta.y / sample.deltaTime;
-        sampleVel.z = sample.delta.z / sample.deltaTime;
-
-        float speed = std::sqrt(sampleVel.x * sampleVel.x +
-                                sampleVel.y * sampleVel.y +
-                                sampleVel.z * sampleVel.z);
-
-        if (speed < 0.001f) continue;
-
-        // Direction filter: reject samples that deviate too much from dominant direction
-        if (filterEnabled) {
-            // Normalize sample direction
-            RE::NiPoint3 sampleDir;
-            sampleDir.x = sampleVel.x / speed;
-            sampleDir.y = sampleVel.y / speed;
-            sampleDir.z = sampleVel.z / speed;
-
-            // Dot product = cos(angle between vectors)
-            float dot = sampleDir.x * dominantDir.x +
-                        sampleDir.y * dominantDir.y +
-                        sampleDir.z * dominantDir.z;
-
-            if (dot < cosThreshold) {
-                rejectedSamples++;
-                continue;  // Outside allowed cone, skip this sample
-            }
-        }
-
-        // Weight = speed^exponent
-        float weight = std::pow(speed, exponent);
-
-        // Accumulate weighted velocity
-        weightedVelocity.x += sampleVel.x * weight;
-        weightedVelocity.y += sampleVel.y * weight;
-        weightedVelocity.z += sampleVel.z * weight;
-        totalWeight += weight;
+    // The history isn't read at all when the controller velocity is the whole estimate
+    VelocityHistory::Estimate estimate;
+    if (!hasTracked || trackedWeight < 1.0f) {
+        estimate = m_velocityHistory.EstimateVelocity(cosThreshold);
     }
+    int rejectedSamples = estimate.rejectedSamples;
+    float totalWeight = estimate.totalWeight;
 
-    if (totalWeight <= 0.0f) {
+    if (totalWeight <= 0.0f && !hasTracked) {
         return RE::NiPoint3{0.0f, 0.0f, 0.0f};
     }
 
-    // Normalize by total weight to get weighted average velocity
-    RE::NiPoint3 avgVelocity;
-    avgVelocity.x = weightedVelocity.x / totalWeight;
-    avgVelocity.y = weightedVelocity.y / totalWeight;
-    avgVelocity.z = weightedVelocity.z / totalWeight;
+    RE::NiPoint3 avgVelocity = ToNiPoint(estimate.velocity);
 
     float avgSpeed = std::sqrt(avgVelocity.x * avgVelocity.x + avgVelocity.y * avgVelocity.y + avgVelocity.z * avgVelocity.z);
     spdlog::info("  Weighted avg velocity: ({:.1f},{:.1f},{:.1f}) speed={:.1f} u/s, totalWeight={:.1f}, rejected={}",
         avgVelocity.x, avgVelocity.y, avgVelocity.z, avgSpeed, totalWeight, rejectedSamples);
 
+    if (hasTracked) {
+        // Without usable history samples the controller is all there is to go on
+        float blend = totalWeight > 0.0f ? trackedWeight : 1.0f;
+        avgVelocity = avgVelocity + (trackedVelocity - avgVelocity) * blend;
+        spdlog::info("  Tracked controller velocity: ({:.1f},{:.1f},{:.1f}), blend={:.2f} -> ({:.1f},{:.1f},{:.1f})",
+            trackedVelocity.x, trackedVelocity.y, trackedVelocity.z, blend, avgVelocity.x, avgVelocity.y, avgVelocity.z);
+    }
+
     // Calculate launch multiplier and max speed based on equipment and race
     auto* equipMgr = EquipmentManager::GetSingleton();
     bool isBeast = equipMgr->IsInBeastForm();
@@ -1052,7 +1367,7 @@ RE::NiPoint3 ClimbManager::CalculateLaunchVelocity() const
         spdlog::info("Launch velocity{}: ({:.1f}, {:.1f}, {:.1f}), speed={:.1f}, samples={}, exp={:.1f}, filter={:.0f}°, rejected={}",
             modeStr,
             velocity.x, velocity.y, velocity.z, speed,
-            m_velocityHistory.size(), exponent, filterAngle, rejectedSamples);
+            m_velocityHistory.Size(), exponent, filterAngle, rejectedSamples);
     }
 
     return velocity;
@@ -1095,14 +1410,19 @@ void ClimbManager::HandleAutoCatch(uint8_t catchResult)
     // But only if player has stamina to climb
     bool canClimb = StaminaDrainManager::GetSingleton()->CanStartClimbing();
 
-    if (leftCatch && m_leftGripHeld && !m_leftGrabbing && canClimb) {
+    // The catch probes already found a surface - the grab check only supplies the anchor (none if it misses)
+    if (leftCatch && m_leftGripHeld && !IsHandGrabbing(true) && canClimb) {
         spdlog::info("ClimbManager: Auto-catch -> left hand grab (grip was held)");
-        StartClimb(true);
+        RaycastResult contact{};
+        FindGrabContact(true, contact);
+        StartClimb(true, contact);
     }
 
-    if (rightCatch && m_rightGripHeld && !m_rightGrabbing && canClimb) {
+    if (rightCatch && m_rightGripHeld && !IsHandGrabbing(false) && canClimb) {
         spdlog::info("ClimbManager: Auto-catch -> right hand grab (grip was held)");
-        StartClimb(false);
+        RaycastResult contact{};
+        FindGrabContact(false, contact);
+        StartClimb(false, contact);
     }
 
 }
@@ -1113,10 +1433,10 @@ void ClimbManager::ForceReleaseAllGrips()
     // when player takes significant damage while climbing
     spdlog::info("ClimbManager: Force releasing all grips");
 
-    if (m_leftGrabbing) {
+    if (IsHandGrabbing(true)) {
         StopClimb(true);
     }
-    if (m_rightGrabbing) {
+    if (IsHandGrabbing(false)) {
         StopClimb(false);
     }
 }
@@ -1127,15 +1447,11 @@ void ClimbManager::ForceReleaseAllGripsNoLaunch()
     // Used when menu opens - we just want to cleanly exit climbing state
     spdlog::info("ClimbManager: Force releasing all grips (no launch)");
 
-    bool wasClimbing = m_leftGrabbing || m_rightGrabbing;
+    bool wasClimbing = IsClimbing();
 
     // Reset grab states
-    if (m_leftGrabbing) {
-        m_leftGrabbing = false;
-    }
-    if (m_rightGrabbing) {
-        m_rightGrabbing = false;
-    }
+    m_grabs[0].grabbing = false;
+    m_grabs[1].grabbing = false;
 
     if (wasClimbing) {
         // Notify managers
@@ -1170,11 +1486,12 @@ void ClimbManager::ForceReleaseAllGripsNoLaunch()
         }
 
         // Clear velocity history
-        m_velocityHistory.clear();
+        m_velocityHistory.Clear();
 
         // Reset smoothing state
-        m_hasTargetPosition = false;
-        m_hasLastUpdateTime = false;
+        ResetSmoothing();
+        m_hasSimPosition = false;
+        m_unsampledTime = 0.0f;
 
         spdlog::info("ClimbManager: Cleanly exited climbing state (gravity restored to {})", m_savedGravity);
     }
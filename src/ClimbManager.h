@@ -3,10 +3,16 @@
 #include "VRHookAPI.h"
 #include "InputManager.h"
 #include "higgsinterface001.h"
+#include "VelocityHistory.h"
+#include "FixedTimestep.h"
+#include "ClimbSmoother.h"
+#include "FrameContext.h"
+#include "HandPosePredictor.h"
+#include "GrabReadinessTracker.h"
+#include "util/Raycast.h"
 #include "RE/Skyrim.h"
 #include "SKSE/Trampoline.h"
 #include <chrono>
-#include <deque>
 
 // Manages VR climbing mechanics
 // When player grips while touching climbable surfaces, they can pull themselves around
@@ -22,7 +28,8 @@ public:
     void Shutdown();
 
     bool IsInitialized() const { return m_initialized; }
-    bool IsClimbing() const { return m_leftGrabbing || m_rightGrabbing; }
+    bool IsClimbing() const { return m_grabs[0].grabbing || m_grabs[1].grabbing; }
+    bool IsHandGrabbing(bool isLeft) const { return m_grabs[isLeft ? 0 : 1].grabbing; }
 
     // Check if player is in beast form (werewolf or vampire lord)
     static bool IsPlayerInBeastForm();
@@ -45,61 +52,135 @@ private:
     // Original function pointer (stored by trampoline)
     static inline REL::Relocation<decltype(OnMainThreadUpdate)> s_originalFunc;
 
+    // HIGGS pre-physics step callback - resolves deferred raycasts before the physics step,
+    // and runs climbing movement once per Havok step when physicsStepClimbing is enabled
+    static void PrePhysicsStepCallback(void* world);
+
     // Input callbacks - return true to consume input
+    // Run on the main thread when InputManager drains the grip edges queued by the input hook
     bool OnGripPressed(bool isLeft);
     bool OnGripReleased(bool isLeft);
 
-    // Per-frame climbing logic (called from physics step)
-    void UpdateClimbing();
+    // Whether a hand can grab right now and the contact it would grab - the cached readiness answer
+    // when it still holds, otherwise the check runs now (and is cached for the next press)
+    bool FindGrabContact(bool isLeft, RaycastResult& outContact);
+
+    // Publish which grip presses the input hook should block right away (it can't look for surfaces itself)
+    void UpdateGripConsumption(const FrameContext& frame);
+
+    // Climbing logic - once per frame from the main thread hook, once per Havok step from the
+    // pre-physics callback when physicsStepClimbing is enabled, or per fixed step when fixedStepRate is set
+    void UpdateClimbing(float deltaTime);
+
+    // Run the fixed steps due this frame, then display the player between the last two of them
+    void UpdateClimbingFixedStep(float frameDeltaTime);
+
+    // Force release all grips if a game-stopping menu is open - returns true if it released
+    bool ReleaseGripsIfGameStopped();
 
     // Start/stop climbing for a specific hand
-    void StartClimb(bool isLeft);
+    // contact is what the grab check found (no hit when none is known) - it becomes the hand's anchor
+    void StartClimb(bool isLeft, const RaycastResult& contact);
     void StopClimb(bool isLeft);
 
     // Apply smoothed climbing movement to player
+    // Teleports to the smoothed position, or in velocity mode sets the controller velocity that reaches it
     void ApplyClimbMovement(float deltaTime);
 
-    // Get current hand position in world space
+    // Get current hand position in world space (predicted to display time when hand prediction is on)
     RE::NiPoint3 GetHandWorldPosition(bool isLeft) const;
 
+    // Movement of the player this sample from the grabbing hands (averaged over them), updating their offsets
+    RE::NiPoint3 SampleHandMovement(const RE::NiPoint3& playerPos);
+
+    // Physics-step climbing: movement of the player from the grabbing hands' OpenVR poses since the previous
+    // step, carried into their offsets so the next node sample doesn't count it again - false if none moved
+    bool SampleStepHandMovement(RE::NiPoint3& outDelta);
+
+    // Body capsule swept from currentPos toward the target position - false if the target is already reached
+    bool BuildBodySweep(const RE::NiPoint3& currentPos, CapsuleSweepRequest& outSweep) const;
+
+    // Clamp the target position to the contact of a sweep from currentPos, sliding along the surface
+    void ResolveBodySweep(const RE::NiPoint3& currentPos, const CapsuleSweepRequest& sweep, const RaycastResult& contact);
+
+    // Forget the smoothing target (the next grab restarts from wherever the player is)
+    void ResetSmoothing();
+
+    // Position one step of smoothing moves currentPos toward the target position
+    RE::NiPoint3 SmoothTowardTarget(const RE::NiPoint3& currentPos, float deltaTime);
+
+    // Record where a hand latched - a grab on a moving object (kAnimStatic contact with a reference)
+    // is kept in the object's local frame
+    void SetGrabAnchor(bool isLeft, const RE::NiPoint3& handPos, const RaycastResult& contact);
+
+    // How far the moving objects the player holds carried the grab points since the last call
+    // (averaged over the hands), from their transforms - no queries
+    RE::NiPoint3 SampleAnchorMotion();
+
+    // Ballistic flight and the post-flight auto-catch window (TickRegistry::Tick::kBallisticFlight)
+    void UpdateFlight(const FrameContext& frame);
+
     // State
     bool m_initialized = false;
 
     // Climbing state per hand
-    bool m_leftGrabbing = false;
-    bool m_rightGrabbing = false;
+    struct GrabState {
+        bool grabbing = false;
 
-    // Grab anchor points in world space (where hand was when grip started)
-    RE::NiPoint3 m_leftGrabPoint;
-    RE::NiPoint3 m_rightGrabPoint;
+        // Grab anchor point in world space (where the hand was when grip started)
+        // On a moving object the point follows it (see anchorRef)
+        RE::NiPoint3 grabPoint;
 
-    // Previous hand offsets from player (not world positions!) for delta calculation
-    // Using offsets ensures player movement doesn't affect the delta calculation
-    RE::NiPoint3 m_leftPrevHandOffset;
-    RE::NiPoint3 m_rightPrevHandOffset;
+        // Moving object the hand grabbed (kAnimStatic) and the grab point in its local frame - the player
+        // is carried by the point's motion each frame. Empty for everything else.
+        RE::ObjectRefHandle anchorRef;
+        RE::NiPoint3 anchorLocal;
+
+        // Previous hand offset from player (not world position!) for delta calculation
+        // Using offsets ensures player movement doesn't affect the delta calculation
+        RE::NiPoint3 prevHandOffset;
+    };
+    GrabState m_grabs[2];  // Left=0, Right=1
 
     // Saved gravity value to restore after climbing
     float m_savedGravity = 0.0f;
     bool m_gravityDisabled = false;
 
-    // Input callback IDs
-    InputManager::CallbackId m_gripCallbackId = InputManager::InvalidCallbackId;
-
     // Position smoothing
     RE::NiPoint3 m_targetPosition;           // Target position we're smoothing toward
     bool m_hasTargetPosition = false;        // Whether target position is valid
-    std::chrono::steady_clock::time_point m_lastUpdateTime;
-    bool m_hasLastUpdateTime = false;
+    ClimbSmoother m_smoother;                // Step toward the target (Config::options smoothing mode)
+
+    // Input callback IDs
+    InputManager::CallbackId m_gripCallbackId = InputManager::InvalidCallbackId;
+
+    // Fixed-step simulation (fixedStepRate > 0)
+    static constexpr int MAX_FIXED_STEPS_PER_FRAME = 5;  // Steps beyond this in one frame are dropped
+    FixedTimestep m_fixedStep;                // Climbing step accumulator
+    FixedTimestep m_flightStep;               // Ballistic flight step accumulator
+    RE::NiPoint3 m_simPosition;               // Player position as of the last climbing step
+    RE::NiPoint3 m_prevSimPosition;           // Player position as of the step before
+    RE::NiPoint3 m_displayedPosition;         // Interpolated position last given to the player
+    bool m_hasSimPosition = false;            // Climbing steps move m_simPosition instead of the player
+
+    // HMD position relative to the player, taken at the top of each frame (the body sweep's head)
+    RE::NiPoint3 m_hmdOffset;
+    bool m_hasHmdOffset = false;
+
+    // Physics-step and fixed-step climbing: hands are sampled once per rendered frame
+    uint32_t m_frameCount = 0;               // Rendered frames (main thread updates)
+    uint32_t m_handSampleFrame = 0;          // Frame the hands were last sampled on
+    float m_unsampledTime = 0.0f;            // Step time since the last hand sample
+
+    // Wand poses extrapolated to display time for grabbing and pulling, and OpenVR controller velocities for launches
+    HandPosePredictor m_posePredictor;
 
     // Velocity tracking for launch mechanics
-    struct VelocitySample {
-        RE::NiPoint3 delta;      // Movement delta this frame
-        float deltaTime;         // Time for this sample
-    };
-    std::deque<VelocitySample> m_velocityHistory;
+    VelocityHistory m_velocityHistory;
 
     // Calculate launch velocity from recent movement history
-    RE::NiPoint3 CalculateLaunchVelocity() const;
+    // releasedLeft: the hand whose release ended the climb (its controller velocity is blended in)
+    RE::NiPoint3 CalculateLaunchVelocity(bool releasedLeft) const;
 
     // Apply launch velocity to player
     void ApplyLaunch(const RE::NiPoint3& velocity);
@@ -109,6 +190,9 @@ private:
     bool m_leftGripHeld = false;
     bool m_rightGripHeld = false;
 
+    // Cached per-hand grab checks - grip presses and the input hook's consumption snapshot read these
+    GrabReadinessTracker m_grabReadiness;
+
     // Handle auto-catch: when ballistic flight ends due to surface detection under hands
     void HandleAutoCatch(uint8_t catchResult);
 };
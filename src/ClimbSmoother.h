@@ -0,0 +1,64 @@
+#pragma once
+
+#include "OneEuroFilter.h"
+#include "util/QueryBackend.h"
+#include <cmath>
+
+// One step of climbing position smoothing: how far the player moves toward the target position
+// Free of CommonLib types (like VelocityHistory, FixedTimestep and OneEuroFilter), so tools/replay runs
+// recorded hand movement through the same smoothing as ClimbManager.
+class ClimbSmoother
+{
+public:
+    // The Config::options smoothing values a step reads
+    struct Settings {
+        int mode = 0;                          // smoothingMode: 0 = exponential, 1 = One-Euro adaptive
+        float speed = 13.0f;                   // smoothingSpeed
+        float oneEuroMinCutoff = 1.0f;
+        float oneEuroBeta = 0.06f;
+        float oneEuroDerivativeCutoff = 1.0f;
+    };
+
+    // Position one step of smoothing moves currentPos toward targetPos
+    PhysicsQuery::Vec3 Step(const PhysicsQuery::Vec3& currentPos, const PhysicsQuery::Vec3& targetPos, float deltaTime,
+        const Settings& settings)
+    {
+        // Per-axis smoothing factors toward the target
+        float smoothFactor[3];
+        if (settings.mode == 1) {
+            // One-Euro: the cutoff follows how fast each axis of the target moves - fast pulls track
+            // closely, a hanging player's jitter is smoothed out
+            const float target[3] = { targetPos.x, targetPos.y, targetPos.z };
+            for (int axis = 0; axis < 3; ++axis) {
+                smoothFactor[axis] = m_filters[axis].Update(target[axis], deltaTime, settings.oneEuroMinCutoff,
+                    settings.oneEuroBeta, settings.oneEuroDerivativeCutoff);
+            }
+        } else {
+            // Exponential smoothing - smoothFactor = 1 - exp(-speed * deltaTime)
+            float factor = 1.0f - std::exp(-settings.speed * deltaTime);
+
+            // Clamp to valid range [0, 1]
+            if (factor < 0.0f) factor = 0.0f;
+            if (factor > 1.0f) factor = 1.0f;
+            smoothFactor[0] = smoothFactor[1] = smoothFactor[2] = factor;
+        }
+
+        // Smooth toward (possibly clamped) target - single smoothing handles everything
+        return {
+            currentPos.x + (targetPos.x - currentPos.x) * smoothFactor[0],
+            currentPos.y + (targetPos.y - currentPos.y) * smoothFactor[1],
+            currentPos.z + (targetPos.z - currentPos.z) * smoothFactor[2]
+        };
+    }
+
+    // Next step starts the One-Euro filters from rest
+    void Reset()
+    {
+        for (auto& filter : m_filters) {
+            filter.Reset();
+        }
+    }
+
+private:
+    OneEuroFilter m_filters[3];  // Per-axis adaptive smoothing (mode 1)
+};
@@ -1,19 +1,22 @@
 #include "ClimbSurfaceDetector.h"
-#include "ClimbManager.h"
 #include "BallisticController.h"
 #include "Config.h"
-#include "util/VRNodes.h"
 #include "util/Raycast.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <cmath>
 
+// The 6 probe rays are reach * sqrt(2) apart at the reach, so a ledge or pole thinner than that can sit between
+// them unseen - a miss only vouches for this fraction of the reach, however far the nearest sampled surface is
+static constexpr float MAX_MISS_MARGIN_FRACTION = 0.25f;
+
 // Get effective ray length - uses config values, extended during ballistic flight
-static float GetEffectiveRayLength()
+static float GetEffectiveRayLength(const FrameContext& frame)
 {
     float length;
 
     // Beast forms use separate config value
-    if (ClimbManager::IsPlayerInBeastForm()) {
+    if (frame.isBeastForm) {
         length = Config::options.beastGrabRayLength;
     } else {
         length = Config::options.grabRayLength;
@@ -27,32 +30,74 @@ static float GetEffectiveRayLength()
     return length;
 }
 
-bool ClimbSurfaceDetector::CanGrabSurface(bool isLeft)
+bool ClimbSurfaceDetector::CanGrabSurface(const FrameContext& frame, bool isLeft)
+{
+    RaycastResult contact;
+    return FindGrabContact(frame, isLeft, contact);
+}
+
+bool ClimbSurfaceDetector::FindGrabContact(const FrameContext& frame, bool isLeft, RaycastResult& outContact)
 {
-    RE::NiPoint3 handPos = GetHandPosition(isLeft);
+    float margin;
+    return FindGrabContact(frame, isLeft, outContact, margin);
+}
+
+bool ClimbSurfaceDetector::FindGrabContact(const FrameContext& frame, bool isLeft, RaycastResult& outContact, float& outMargin)
+{
+    outMargin = 0.0f;
+    RE::NiPoint3 handPos = GetHandPosition(frame, isLeft);
 
     // Check if we got a valid position
     if (handPos.x == 0.0f && handPos.y == 0.0f && handPos.z == 0.0f) {
         return false;
     }
 
-    // First try the 6 cardinal directions
-    if (CastMultiDirectionalRays(handPos)) {
+    // Nearest climbable surface along the 6 cardinal directions within reach of the hand
+    // Climbable layers are exactly LayerMasks::kSolid (see IsClimbableLayer)
+    // Probing a little further than the reach costs nothing extra and tells how far away a miss was
+    float reach = GetEffectiveRayLength(frame);
+    float probeLength = reach * (1.0f + MAX_MISS_MARGIN_FRACTION);
+    RAYCAST_QUERY_SITE(kSurfaceDetectorRays);
+    // The contact becomes the grab anchor, so it carries the hit reference (see ClimbManager::SetGrabAnchor)
+    RaycastResult nearest = Raycast::CastMultiDirectionalRays(handPos, probeLength, LayerMasks::kSolid,
+        RaycastOutputs::kLayer | RaycastOutputs::kHitRef);
+    if (nearest.hit && nearest.distance <= reach) {
+        spdlog::trace("ClimbSurfaceDetector: Hit climbable surface (layer {}) at distance {}",
+                      static_cast<int>(nearest.collisionLayer), nearest.distance);
+        outContact = nearest;
+        outMargin = reach - nearest.distance;
         return true;
     }
+    float missMargin = (nearest.hit ? nearest.distance : probeLength) - reach;
 
-    // If no hit, try casting from hand toward HMD
+    // If no hit, cast from HMD toward the hand
     // This catches the case where hand is already inside a collider
     // (colliders are often larger than visible geometry)
-    return CastRayTowardHMD(handPos);
+    RaycastRequest request;
+    if (!BuildRayTowardHMD(frame, handPos, request)) {
+        outContact = nearest;
+        outMargin = missMargin;
+        return false;
+    }
+
+    request.outputs |= RaycastOutputs::kHitRef;
+    RAYCAST_QUERY_SITE(kSurfaceDetectorHMD);
+    outContact = Raycast::CastRay(request.origin, request.direction, request.maxDistance, request.layerMask, request.outputs);
+
+    // Something between the head and the hand - the hand may be inside or behind it, so there is no margin
+    outMargin = outContact.hit ? 0.0f : missMargin;
+    return outContact.hit && IsClimbableLayer(outContact.collisionLayer);
 }
 
-RE::NiPoint3 ClimbSurfaceDetector::GetHandPosition(bool isLeft)
+float ClimbSurfaceDetector::GetGrabReach(const FrameContext& frame)
 {
-    RE::NiAVObject* handNode = isLeft ? VRNodes::GetLeftHand() : VRNodes::GetRightHand();
+    return GetEffectiveRayLength(frame);
+}
 
-    if (handNode) {
-        return handNode->world.translate;
+RE::NiPoint3 ClimbSurfaceDetector::GetHandPosition(const FrameContext& frame, bool isLeft)
+{
+    if (frame.HasHand(isLeft)) {
+        return frame.GetHand(isLeft).translate;
     }
 
     return RE::NiPoint3{0.0f, 0.0f, 0.0f};
@@ -78,25 +123,26 @@ bool ClimbSurfaceDetector::IsClimbable(RE::COL_LAYER layer)
     return IsClimbableLayer(layer);
 }
 
-bool ClimbSurfaceDetector::CastMultiDirectionalRays(const RE::NiPoint3& origin)
+bool ClimbSurfaceDetector::BuildDirectionalProbe(const FrameContext& frame, bool isLeft, const RE::NiPoint3& direction, RaycastRequest& outRequest)
 {
-    // 6 cardinal directions: +X, -X, +Y, -Y, +Z, -Z
-    static const RE::NiPoint3 directions[] = {
-        { 1.0f,  0.0f,  0.0f},  // +X (right)
-        {-1.0f,  0.0f,  0.0f},  // -X (left)
-        { 0.0f,  1.0f,  0.0f},  // +Y (forward)
-        { 0.0f, -1.0f,  0.0f},  // -Y (backward)
-        { 0.0f,  0.0f,  1.0f},  // +Z (up)
-        { 0.0f,  0.0f, -1.0f},  // -Z (down)
-    };
+    RE::NiPoint3 handPos = GetHandPosition(frame, isLeft);
 
-    float rayLength = GetEffectiveRayLength();
+    // Check if we got a valid position
+    if (handPos.x == 0.0f && handPos.y == 0.0f && handPos.z == 0.0f) {
+        return false;
+    }
+
+    // Grab checks only read the layer - skip the hit reference lookup
+    outRequest = RaycastRequest{ handPos, direction, GetEffectiveRayLength(frame), LayerMasks::kAll, RaycastOutputs::kLayer };
+    return true;
+}
 
-    for (const auto& dir : directions) {
-        RaycastResult result = Raycast::CastRay(origin, dir, rayLength);
+bool ClimbSurfaceDetector::EvaluateProbe(std::span<const RaycastResult> results)
+{
+    for (const auto& result : results) {
         if (result.hit && IsClimbableLayer(result.collisionLayer)) {
-            spdlog::trace("ClimbSurfaceDetector: Hit climbable surface (layer {}) at distance {} (rayLen: {})",
-                          static_cast<int>(result.collisionLayer), result.distance, rayLength);
+            spdlog::trace("ClimbSurfaceDetector: Hit climbable surface (layer {}) at distance {}",
+                          static_cast<int>(result.collisionLayer), result.distance);
             return true;
         }
     }
@@ -104,18 +150,15 @@ bool ClimbSurfaceDetector::CastMultiDirectionalRays(const RE::NiPoint3& origin)
     return false;
 }
 
-bool ClimbSurfaceDetector::CastRayInDirection(bool isLeft, const RE::NiPoint3& direction)
+bool ClimbSurfaceDetector::CastRayInDirection(const FrameContext& frame, bool isLeft, const RE::NiPoint3& direction)
 {
-    RE::NiPoint3 handPos = GetHandPosition(isLeft);
-
-    // Check if we got a valid position
-    if (handPos.x == 0.0f && handPos.y == 0.0f && handPos.z == 0.0f) {
+    RaycastRequest request;
+    if (!BuildDirectionalProbe(frame, isLeft, direction, request)) {
         return false;
     }
 
-    float rayLength = GetEffectiveRayLength();
-
-    RaycastResult result = Raycast::CastRay(handPos, direction, rayLength);
+    RAYCAST_QUERY_SITE(kSurfaceDetectorDirectional);
+    RaycastResult result = Raycast::CastRay(request.origin, request.direction, request.maxDistance, request.layerMask, request.outputs);
     if (result.hit && IsClimbableLayer(result.collisionLayer)) {
         return true;
     }
@@ -123,15 +166,14 @@ bool ClimbSurfaceDetector::CastRayInDirection(bool isLeft, const RE::NiPoint3& d
     return false;
 }
 
-bool ClimbSurfaceDetector::CastRayTowardHMD(const RE::NiPoint3& handPos)
+bool ClimbSurfaceDetector::BuildRayTowardHMD(const FrameContext& frame, const RE::NiPoint3& handPos, RaycastRequest& outRequest)
 {
     // Get HMD position
-    RE::NiAVObject* hmdNode = VRNodes::GetHMD();
-    if (!hmdNode) {
+    if (!frame.hasHmd) {
         return false;
     }
 
-    RE::NiPoint3 hmdPos = hmdNode->world.translate;
+    RE::NiPoint3 hmdPos = frame.hmd.translate;
 
     // Calculate direction from HMD to hand (reversed from original)
     RE::NiPoint3 toHand = {
@@ -157,11 +199,6 @@ bool ClimbSurfaceDetector::CastRayTowardHMD(const RE::NiPoint3& handPos)
     // If we hit a climbable surface before reaching the hand, that surface is
     // between the player's view and their hand = hand is at/near/inside it = valid grab!
     // (Casting from inside a collider doesn't detect hits, so we cast from outside)
-    RaycastResult result = Raycast::CastRay(hmdPos, direction, distance);
-
-    if (result.hit && IsClimbableLayer(result.collisionLayer)) {
-        return true;
-    }
-
-    return false;
+    outRequest = RaycastRequest{ hmdPos, direction, distance, LayerMasks::kAll, RaycastOutputs::kLayer };
+    return true;
 }
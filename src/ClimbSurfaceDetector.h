@@ -1,35 +1,56 @@
 #pragma once
 
 #include "RE/Skyrim.h"
+#include "FrameContext.h"
+#include "util/Raycast.h"
+#include <span>
 
 // Detects climbable surfaces near VR hands using short-range raycasts
 // Used to determine if a grip action should initiate climbing
+// Hand/HMD positions and beast form are read from the frame the check runs in
 class ClimbSurfaceDetector
 {
 public:
     // Check if there's a climbable surface near the specified hand
-    // Casts short rays in multiple directions from the hand position
-    // Returns true if any ray hits climbable geometry within range
-    static bool CanGrabSurface(bool isLeft);
+    // Casts the 6 cardinal rays from the hand, falling back to a ray from the HMD toward the hand
+    // Returns true if climbable geometry is within range
+    static bool CanGrabSurface(const FrameContext& frame, bool isLeft);
+
+    // Same check as CanGrabSurface, but also reports the nearest climbable contact
+    // outContact receives the contact point, layer and hit reference (only valid if this returns true)
+    static bool FindGrabContact(const FrameContext& frame, bool isLeft, RaycastResult& outContact);
+
+    // Same check, also reporting outMargin: how far the hand and HMD can move before the answer can change - the
+    // reach left to the contact on a hit, the gap between the reach and the nearest surface on a miss (at most a
+    // quarter of the reach, since the sampled rays can pass either side of thin geometry), 0 when the HMD ray decided
+    static bool FindGrabContact(const FrameContext& frame, bool isLeft, RaycastResult& outContact, float& outMargin);
+
+    // How far from the hand a surface can be grabbed this frame (extended for beast forms and during flight)
+    static float GetGrabReach(const FrameContext& frame);
 
     // Cast a ray in a specific direction from hand position
     // Returns true if a climbable surface is hit within effective ray length
-    static bool CastRayInDirection(bool isLeft, const RE::NiPoint3& direction);
+    static bool CastRayInDirection(const FrameContext& frame, bool isLeft, const RE::NiPoint3& direction);
 
     // Check if a collision layer represents a climbable surface
     static bool IsClimbable(RE::COL_LAYER layer);
 
+    // Build a single ray from the hand in a fixed direction (see CastRayInDirection)
+    // Returns false if the hand position is unavailable
+    static bool BuildDirectionalProbe(const FrameContext& frame, bool isLeft, const RE::NiPoint3& direction, RaycastRequest& outRequest);
+
+    // Returns true if any result of a grab/directional probe hit a climbable surface
+    static bool EvaluateProbe(std::span<const RaycastResult> results);
+
 private:
-    // Get hand position for raycasting
-    static RE::NiPoint3 GetHandPosition(bool isLeft);
+    // Get hand position for raycasting (origin if the hand isn't tracked this frame)
+    static RE::NiPoint3 GetHandPosition(const FrameContext& frame, bool isLeft);
 
     // Internal implementation of climbable check
     static bool IsClimbableLayer(RE::COL_LAYER layer);
 
-    // Cast rays in all directions and return true if any hit a climbable surface
-    static bool CastMultiDirectionalRays(const RE::NiPoint3& origin);
-
-    // Cast ray from hand toward HMD to detect if hand is inside a collider
+    // Build the ray from HMD toward the hand to detect if hand is inside a collider
     // Colliders are often larger than visible geometry, so hand may already be inside
-    static bool CastRayTowardHMD(const RE::NiPoint3& handPos);
+    // Returns false if the HMD is unavailable or coincides with the hand
+    static bool BuildRayTowardHMD(const FrameContext& frame, const RE::NiPoint3& handPos, RaycastRequest& outRequest);
 };
@@ -26,6 +26,15 @@ namespace Config {
 ; Armor weight is scaled by armor skill - higher skill = less effective weight
 ; Exponential smoothing factor for movement (higher = snappier)
 smoothingSpeed=13.0
+; Movement smoothing mode: 0 = exponential (smoothingSpeed), 1 = One-Euro adaptive
+; One-Euro smooths hard while hanging still (removes tracking jitter) and barely at all on fast pulls (less lag)
+smoothingMode=0
+; One-Euro cutoff frequency with the hands still (Hz) - lower is steadier
+oneEuroMinCutoff=1.0
+; How much the cutoff rises per unit/s of pull speed - higher tracks fast pulls more closely
+oneEuroBeta=0.06
+; Cutoff frequency for the pull speed estimate (Hz)
+oneEuroDerivativeCutoff=1.0
 ; Base max launch speed (units/sec)
 baseLaunchSpeed=450.0
 ; Max velocity multiplier applied to launches
@@ -126,7 +135,7 @@ minLaunchSpeed=5.0
 horizontalLaunchBoost=1.0
 ; Seconds of velocity samples to keep for launch calculation
 velocityHistoryTime=0.2
-; Maximum number of velocity samples to track
+; Maximum number of velocity samples to track (1-64)
 maxVelocitySamples=10
 ; Exponent for velocity weighting in launch calculation
 ; 1.0 = linear (fast frames have proportional influence)
@@ -136,6 +145,9 @@ velocityWeightExponent=1.0
 ; Samples outside this cone are rejected as outliers (e.g. wrist rotation)
 ; Set to 0 to disable filtering
 launchDirectionFilter=60.0
+; Blend the controller velocity reported by OpenVR (IMU-fused, no history lag) into the launch velocity
+; 0 = movement history only, 1 = controller velocity only (history is used if the controller isn't tracking)
+trackedLaunchVelocityWeight=0.0
 ; Duration of ghost mode after launch (seconds, 0=disabled)
 ; Ghost mode temporarily disables world collision to prevent getting stuck on
 ; Disabled by default because it sometimes causes the player to fly out of bounds
@@ -148,6 +160,26 @@ minFlightTime=0.5
 ; Maximum velocity to allow landing (units/sec, 0=disabled)
 ; Player won't land while moving faster than this
 maxLandingVelocity=50.0
+; Update climbing movement from the physics step instead of once per rendered frame (1=enabled, 0=disabled)
+; Tracks Havok's step rate with the freshest hand poses - lower latency and less judder on 120/144 Hz headsets
+physicsStepClimbing=0
+; Simulate climbing and flight at a fixed rate in Hz instead of once per rendered frame (0=disabled)
+; Movement no longer depends on frame pacing; the player is displayed between the last two steps
+; Ignored for climbing while physicsStepClimbing or velocityClimbing is enabled
+fixedStepRate=0
+; Move the climbing player by setting the character controller's velocity instead of teleporting it every frame
+; Havok's character proxy then moves the body continuously and resolves collisions itself
+; Works best together with physicsStepClimbing, which sets the velocity right before each physics step
+velocityClimbing=0
+; Also sweep the body against walls and floors in velocity mode (normally left to the character proxy)
+velocityClimbingSweep=0
+; Predict hand positions to when the frame is displayed - the body follows arm movement with less lag
+; Uses the controller velocity from OpenVR (or recent hand movement) and never predicts past where a hand stops
+handPredictionEnabled=0
+; How far ahead to predict in seconds (0=one display frame, max 0.05)
+handPredictionTime=0.0
+; Max distance a hand is predicted ahead of its tracked position (game units)
+handPredictionMaxDistance=4.0
 
 [Launching]
 ; Settings for ballistic flight after releasing grip
@@ -175,10 +207,24 @@ enabled=1
 ; Sound volume (0.0-1.0) - multiplied by game's master volume
 volume=0.9
 
+[Performance]
+; Reuse results of identical raycasts issued within the same frame (1=enabled, 0=disabled)
+raycastCacheEnabled=1
+; Per-frame time budget in microseconds for non-urgent physics checks (safe position, critical strike,
+; post-flight auto-catch, grab readiness). Checks that don't fit are spread over the next frames. 0 = no limit
+queryBudgetMicros=300
+; Free hands are re-checked in the background for a surface in reach once they have moved far enough that
+; the last answer may have changed, at most once every this many frames (1 = every frame)
+grabReadinessInterval=3
+
 [Debug]
 ; Hot reload INI when file is modified (1=enabled, 0=disabled)
 ; Disable this for release builds to avoid file system checks every frame
 hotReloadEnabled=0
+; Record every frame's tracked inputs, player position and physics query answers to
+; VRClimbing.vcr in the SKSE log folder, for offline replay with tools/replay (1=enabled, 0=disabled)
+; Can be toggled with hot reload; the file is overwritten when a recording starts
+recordSession=0
 
 [AeloveTweaks]
 ; Sets a minimum amount of Stamina required to be able to climb (set to 0 to disable)
@@ -329,13 +375,25 @@ baseStaminaCostBeast=4.0
         RegisterInt("Climbing", "maxVelocitySamples", options.maxVelocitySamples);
         RegisterFloat("Climbing", "velocityWeightExponent", options.velocityWeightExponent);
         RegisterFloat("Climbing", "launchDirectionFilter", options.launchDirectionFilter);
+        RegisterFloat("Climbing", "trackedLaunchVelocityWeight", options.trackedLaunchVelocityWeight);
         RegisterFloat("Climbing", "ghostModeDuration", options.ghostModeDuration);
         RegisterFloat("Climbing", "ghostModeMinSpeed", options.ghostModeMinSpeed);
         RegisterFloat("Climbing", "minFlightTime", options.minFlightTime);
         RegisterFloat("Climbing", "maxLandingVelocity", options.maxLandingVelocity);
+        RegisterBool("Climbing", "physicsStepClimbing", options.physicsStepClimbing);
+        RegisterInt("Climbing", "fixedStepRate", options.fixedStepRate);
+        RegisterBool("Climbing", "velocityClimbing", options.velocityClimbing);
+        RegisterBool("Climbing", "velocityClimbingSweep", options.velocityClimbingSweep);
+        RegisterBool("Climbing", "handPredictionEnabled", options.handPredictionEnabled);
+        RegisterFloat("Climbing", "handPredictionTime", options.handPredictionTime);
+        RegisterFloat("Climbing", "handPredictionMaxDistance", options.handPredictionMaxDistance);
 
         // Climbing Ability (base values for naked player)
         RegisterFloat("ClimbingAbility", "smoothingSpeed", options.smoothingSpeed);
+        RegisterInt("ClimbingAbility", "smoothingMode", options.smoothingMode);
+        RegisterFloat("ClimbingAbility", "oneEuroMinCutoff", options.oneEuroMinCutoff);
+        RegisterFloat("ClimbingAbility", "oneEuroBeta", options.oneEuroBeta);
+        RegisterFloat("ClimbingAbility", "oneEuroDerivativeCutoff", options.oneEuroDerivativeCutoff);
         RegisterFloat("ClimbingAbility", "baseLaunchSpeed", options.baseLaunchSpeed);
         RegisterFloat("ClimbingAbility", "maxLaunchMultiplier", options.maxLaunchMultiplier);
         RegisterFloat("ClimbingAbility", "baseStaminaCost", options.baseStaminaCost);
@@ -396,8 +454,14 @@ baseStaminaCostBeast=4.0
         RegisterBool("Sound", "enabled", options.soundEnabled);
         RegisterFloat("Sound", "volume", options.soundVolume);
 
+        // Performance settings
+        RegisterBool("Performance", "raycastCacheEnabled", options.raycastCacheEnabled);
+        RegisterInt("Performance", "queryBudgetMicros", options.queryBudgetMicros);
+        RegisterInt("Performance", "grabReadinessInterval", options.grabReadinessInterval);
+
         // Debug settings
         RegisterBool("Debug", "hotReloadEnabled", options.hotReloadEnabled);
+        RegisterBool("Debug", "recordSession", options.recordSession);
 
         // Aelove Tweaks
         RegisterFloat("AeloveTweaks", "minStamina", options.minStamina);
@@ -12,16 +12,28 @@ namespace Config {
         float minLaunchSpeed = 5.0f;                 // Minimum speed to trigger launch (units/s)
         float horizontalLaunchBoost = 1.0f;          // Extra multiplier for horizontal movement
         float velocityHistoryTime = 0.1f;            // Seconds of velocity samples to keep
-        int maxVelocitySamples = 10;                 // Max velocity samples to track
+        int maxVelocitySamples = 10;                 // Max velocity samples to track (1-64)
         float velocityWeightExponent = 1.0f;         // Exponent for velocity weighting (1.0=linear, 2.0=quadratic)
         float launchDirectionFilter = 90.0f;         // Max angle deviation from dominant direction (degrees, 0=disabled)
+        float trackedLaunchVelocityWeight = 0.0f;    // Blend of OpenVR controller velocity into launches (0=hand history only, 1=controller only)
         float ghostModeDuration = 0.15f;             // Duration of ghost mode after launch (seconds, 0=disabled)
         float ghostModeMinSpeed = 200.0f;            // Minimum launch speed to trigger ghost mode (units/s)
         float minFlightTime = 0.5f;                  // Minimum time before allowing landing (seconds)
         float maxLandingVelocity = 200.0f;           // Max velocity to allow landing (units/s, 0=disabled)
+        bool physicsStepClimbing = false;            // Move the climbing player from the physics pre-step instead of once per frame
+        int fixedStepRate = 0;                       // Climbing/flight simulation rate in Hz (0=once per frame)
+        bool velocityClimbing = false;               // Move the climbing player through character controller velocity instead of SetPosition
+        bool velocityClimbingSweep = false;          // Keep the body sweep in velocity mode (the character proxy already collides)
+        bool handPredictionEnabled = false;          // Extrapolate hand poses to display time for grabbing and pulling
+        float handPredictionTime = 0.0f;             // How far ahead to predict (seconds, 0=one display frame)
+        float handPredictionMaxDistance = 4.0f;      // Max distance a hand is predicted ahead (game units)
 
         // ===== Climbing Ability (base values for naked, non-encumbered player) =====
         float smoothingSpeed = 13.0f;                // Exponential smoothing factor for movement
+        int smoothingMode = 0;                       // Movement smoothing (0=exponential, 1=One-Euro adaptive)
+        float oneEuroMinCutoff = 1.0f;               // One-Euro cutoff with the hands still (Hz, lower = steadier)
+        float oneEuroBeta = 0.06f;                   // One-Euro cutoff increase per unit/s of pull speed (higher = less lag)
+        float oneEuroDerivativeCutoff = 1.0f;        // One-Euro cutoff for the speed estimate (Hz)
         float baseLaunchSpeed = 600.0f;              // Base max launch speed (units/s)
         float maxLaunchMultiplier = 1.25f;           // Max velocity multiplier for launches
         float baseStaminaCost = 8.0f;                // Base stamina drain per second
@@ -90,8 +102,14 @@ namespace Config {
         bool soundEnabled = true;                    // Enable climbing/launch sounds
         float soundVolume = 0.5f;                    // Sound volume (0-1), scaled by game master volume
 
+        // ===== Performance =====
+        bool raycastCacheEnabled = true;             // Reuse identical raycast results within a frame
+        int queryBudgetMicros = 300;                 // Per-frame time budget for deferrable physics queries (0 = no limit)
+        int grabReadinessInterval = 3;               // Min frames between background re-checks of a hand's grab readiness
+
         // ===== Debug / Development =====
         bool hotReloadEnabled = false;                // Hot reload INI when modified (disable for release)
+        bool recordSession = false;                   // Record frames and query answers to VRClimbing.vcr (see SessionRecorder)
     };
 
     extern Options options;
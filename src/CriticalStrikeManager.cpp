@@ -1,7 +1,8 @@
 #include "CriticalStrikeManager.h"
 #include "Config.h"
-#include "util/VRNodes.h"
 #include "util/Raycast.h"
+#include "util/QueryScheduler.h"
+#include "util/TickRegistry.h"
 #include <spdlog/spdlog.h>
 #include <cmath>
 #include <algorithm>  // for std::min, std::max
@@ -30,12 +31,15 @@ void CriticalStrikeManager::OnLaunchStart()
 {
     m_inFlight = true;
     m_criticalStrikeTriggered = false;  // Reset for new flight
+    CancelImpactQuery();
+    TickRegistry::Subscribe(TickRegistry::Tick::kCriticalStrike);
     spdlog::debug("CriticalStrikeManager: Launch started, monitoring for critical strike");
 }
 
 void CriticalStrikeManager::OnLaunchEnd()
 {
     m_inFlight = false;
+    CancelImpactQuery();
 
     // Start landing delay for slow-mo if enabled and target wasn't hit
     if (m_slowMotionActive && Config::options.criticalEndOnLand && !m_targetWasHit) {
@@ -53,7 +57,7 @@ void CriticalStrikeManager::OnClimbStart()
     }
 }
 
-void CriticalStrikeManager::Update(uint32_t frameCount)
+void CriticalStrikeManager::Update(const FrameContext& frame)
 {
     // Check if slow-motion timer has expired
     if (m_slowMotionActive) {
@@ -104,6 +108,10 @@ void CriticalStrikeManager::Update(uint32_t frameCount)
 
     // Only check for critical strike during flight
     if (!m_inFlight) {
+        // Landed with no slow-mo left to time out - idle until the next launch
+        if (!m_slowMotionActive) {
+            TickRegistry::Unsubscribe(TickRegistry::Tick::kCriticalStrike);
+        }
         return;
     }
 
@@ -112,26 +120,90 @@ void CriticalStrikeManager::Update(uint32_t frameCount)
         return;
     }
 
+    // Impact ray from an earlier check is resolved in the physics pre-step - evaluate it before throttling
+    if (m_impactTicket != Raycast::kInvalidTicket) {
+        PollImpactQuery(frame);
+        return;
+    }
+
     // Throttle checks to every N frames
-    if (frameCount % static_cast<uint32_t>(Config::options.criticalCheckInterval) != 0) {
+    if (frame.frameNumber % static_cast<uint32_t>(Config::options.criticalCheckInterval) != 0) {
         return;
     }
 
-    // Perform the detection check
-    if (CheckForCriticalStrike()) {
+    // Perform the detection check when the query scheduler has room this frame
+    // (requests coalesce, so calling Update from several loops doesn't queue duplicate checks)
+    QueryScheduler::Request(QueryScheduler::Task::kCriticalStrikeCheck, QueryScheduler::Priority::kHigh, [] {
+        if (const auto* current = FrameContext::GetCurrent()) {
+            CriticalStrikeManager::GetSingleton()->RunScheduledCheck(*current);
+        }
+    });
+}
+
+void CriticalStrikeManager::RunScheduledCheck(const FrameContext& frame)
+{
+    // Flight may have ended or a strike already triggered since the check was requested
+    if (!m_inFlight || m_criticalStrikeTriggered) {
+        return;
+    }
+
+    // Still waiting on the previous impact ray
+    if (m_impactTicket != Raycast::kInvalidTicket) {
+        return;
+    }
+
+    ImpactProbe probe;
+    if (!BuildImpactProbe(frame, probe)) {
+        return;
+    }
+
+    // Check 5: Cast ray in velocity direction to find impact point
+    // Impact point only steers target selection - resolve the ray off the main-thread critical path
+    m_impactTicket = Raycast::SubmitDeferred({ probe.origin, probe.direction, Config::options.criticalRayDistance,
+        LayerMasks::kAll, RaycastOutputs::kNone });
+    if (m_impactTicket != Raycast::kInvalidTicket) {
+        m_pendingImpact = probe;
+        return;
+    }
+
+    // Deferred queue full - cast now
+    RAYCAST_QUERY_SITE(kCriticalImpact);
+    RaycastResult rayResult = Raycast::CastRay(probe.origin, probe.direction, Config::options.criticalRayDistance,
+        LayerMasks::kAll, RaycastOutputs::kNone);
+    if (FindTargetAtImpact(frame, probe, rayResult)) {
+        m_criticalStrikeTriggered = true;
+        StartSlowMotion();
+    }
+}
+
+void CriticalStrikeManager::PollImpactQuery(const FrameContext& frame)
+{
+    RaycastResult rayResult;
+    if (!Raycast::TryGetDeferred(m_impactTicket, rayResult)) {
+        return;  // Not resolved yet
+    }
+    m_impactTicket = Raycast::kInvalidTicket;
+
+    if (FindTargetAtImpact(frame, m_pendingImpact, rayResult)) {
         m_criticalStrikeTriggered = true;
         StartSlowMotion();
     }
 }
 
-bool CriticalStrikeManager::CheckForCriticalStrike()
+void CriticalStrikeManager::CancelImpactQuery()
+{
+    Raycast::CancelDeferred(m_impactTicket);
+    m_impactTicket = Raycast::kInvalidTicket;
+}
+
+bool CriticalStrikeManager::BuildImpactProbe(const FrameContext& frame, ImpactProbe& outProbe) const
 {
     // Check if critical strike system is enabled
     if (!Config::options.criticalStrikeEnabled) {
         return false;
     }
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
+    auto* player = frame.player;
     if (!player) {
         return false;
     }
@@ -143,17 +215,13 @@ bool CriticalStrikeManager::CheckForCriticalStrike()
     }
 
     // Check 2: Get velocity and calculate speed
-    auto* controller = player->GetCharController();
-    if (!controller) {
+    if (!frame.controller) {
         return false;
     }
 
-    RE::hkVector4 hkVelocity;
-    controller->GetLinearVelocityImpl(hkVelocity);
-
-    float vx = hkVelocity.quad.m128_f32[0];
-    float vy = hkVelocity.quad.m128_f32[1];
-    float vz = hkVelocity.quad.m128_f32[2];
+    float vx = frame.havokVelocity.x;
+    float vy = frame.havokVelocity.y;
+    float vz = frame.havokVelocity.z;
     float speed = std::sqrt(vx * vx + vy * vy + vz * vz);
 
     // Check 2a: Speed must meet minimum threshold
@@ -189,7 +257,7 @@ bool CriticalStrikeManager::CheckForCriticalStrike()
     // Check 3: HMD must be roughly aligned with movement direction (if enabled)
     if (Config::options.criticalAngleCheckEnabled) {
         RE::NiPoint3 hmdForward;
-        if (!GetHMDForward(hmdForward)) {
+        if (!GetHMDForward(frame, hmdForward)) {
             return false;
         }
 
@@ -198,16 +266,28 @@ bool CriticalStrikeManager::CheckForCriticalStrike()
         }
     }
 
-    // Check 5: Cast ray in velocity direction to find impact point
+    // Check 5 casts from chest height along the velocity
     RE::NiPoint3 playerPos = player->GetPosition();
     playerPos.z += 50.0f;  // Offset to chest height
 
-    RaycastResult rayResult = Raycast::CastRay(playerPos, velocityDir, Config::options.criticalRayDistance);
+    outProbe.origin = playerPos;
+    outProbe.direction = velocityDir;
+    outProbe.speed = speed;
+    outProbe.diveAngle = diveAngle;
+    return true;
+}
 
+bool CriticalStrikeManager::FindTargetAtImpact(const FrameContext& frame, const ImpactProbe& probe, const RaycastResult& rayResult)
+{
     if (!rayResult.hit) {
         return false;  // No impact point - nothing to land on
     }
 
+    auto* player = frame.player;
+    if (!player) {
+        return false;
+    }
+
     // Check 6: Find actors within detection radius of the IMPACT POINT
     RE::NiPoint3 impactPoint = rayResult.hitPoint;
     const float detectionRadius = Config::options.criticalDetectionRadius;
@@ -266,33 +346,21 @@ bool CriticalStrikeManager::CheckForCriticalStrike()
     float closestDist = std::sqrt(closestDistSq);
     spdlog::info("CriticalStrikeManager: Critical strike detected! Target '{}' (speed: {:.0f}, dive: {:.1f}°, dist: {:.1f}, ray: {:.1f})",
                  closestTarget->GetName(),
-                 speed, diveAngle,
+                 probe.speed, probe.diveAngle,
                  closestDist,
                  rayResult.distance);
 
     return true;
 }
 
-bool CriticalStrikeManager::GetVelocityDirection(RE::NiPoint3& outDirection) const
+bool CriticalStrikeManager::GetVelocityDirection(const FrameContext& frame, RE::NiPoint3& outDirection) const
 {
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return false;
-    }
-
-    auto* controller = player->GetCharController();
-    if (!controller) {
+    if (!frame.controller) {
         return false;
     }
 
-    // Get velocity from character controller
-    RE::hkVector4 hkVelocity;
-    controller->GetLinearVelocityImpl(hkVelocity);
-
-    // Convert to NiPoint3
-    outDirection.x = hkVelocity.quad.m128_f32[0];
-    outDirection.y = hkVelocity.quad.m128_f32[1];
-    outDirection.z = hkVelocity.quad.m128_f32[2];
+    // Velocity from character controller, read at the top of the frame
+    outDirection = frame.havokVelocity;
 
     // Normalize (but keep horizontal for direction check - we don't care about vertical component as much)
     float length = std::sqrt(outDirection.x * outDirection.x +
@@ -310,21 +378,14 @@ bool CriticalStrikeManager::GetVelocityDirection(RE::NiPoint3& outDirection) con
     return true;
 }
 
-bool CriticalStrikeManager::GetHMDForward(RE::NiPoint3& outForward) const
+bool CriticalStrikeManager::GetHMDForward(const FrameContext& frame, RE::NiPoint3& outForward) const
 {
-    auto* hmd = VRNodes::GetHMD();
-    if (!hmd) {
+    if (!frame.hasHmd) {
         return false;
     }
 
-    // Get the forward direction from HMD's rotation matrix
-    // The forward vector is typically the Y-axis in Skyrim's coordinate system
-    const auto& rotation = hmd->world.rotate;
-
-    // Extract forward vector (Y-axis) from rotation matrix
-    outForward.x = rotation.entry[0][1];
-    outForward.y = rotation.entry[1][1];
-    outForward.z = rotation.entry[2][1];
+    // Forward vector is the Y-axis of the HMD's rotation in Skyrim's coordinate system
+    outForward = frame.GetHmdForward();
 
     // Normalize just in case
     float length = std::sqrt(outForward.x * outForward.x +
@@ -366,6 +427,7 @@ void CriticalStrikeManager::StartSlowMotion()
 
     vats->SetMagicTimeSlowdown(Config::options.worldSlowdown, Config::options.playerSlowdown);
     m_slowMotionActive = true;
+    TickRegistry::Subscribe(TickRegistry::Tick::kCriticalStrike);  // Timeouts run in Update
     m_ragdolledActors.clear();      // Reset ragdolled actors for new slow-mo
     m_targetWasHit = false;         // Reset hit flag for new slow-mo
     m_endingDueToLanding = false;   // Reset landing flag for new slow-mo
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "RE/Skyrim.h"
+#include "FrameContext.h"
+#include "util/Raycast.h"
 #include <chrono>
 #include <unordered_set>
 
@@ -24,9 +26,9 @@ public:
     // Called when player starts climbing (ends slow-mo immediately)
     void OnClimbStart();
 
-    // Called every physics frame during ballistic flight
-    // frameCount is used to throttle expensive checks
-    void Update(uint32_t frameCount);
+    // Called every frame (and from the ballistic update during flight)
+    // frame.frameNumber is used to throttle expensive checks
+    void Update(const FrameContext& frame);
 
     // Check if slow-motion is currently active
     bool IsSlowMotionActive() const { return m_slowMotionActive; }
@@ -47,14 +49,37 @@ private:
     CriticalStrikeManager(const CriticalStrikeManager&) = delete;
     CriticalStrikeManager& operator=(const CriticalStrikeManager&) = delete;
 
-    // Core detection logic
-    bool CheckForCriticalStrike();
+    // Flight state that passed the cheap checks (weapon, speed, dive angle, HMD alignment)
+    // and the impact ray to cast from it
+    struct ImpactProbe {
+        RE::NiPoint3 origin;
+        RE::NiPoint3 direction;
+        float speed = 0.0f;
+        float diveAngle = 0.0f;
+    };
 
-    // Get normalized velocity direction from character controller
-    bool GetVelocityDirection(RE::NiPoint3& outDirection) const;
+    // Core detection logic, split around the impact ray
+    // Checks 1-3 - returns false if this flight state can't be a critical strike
+    bool BuildImpactProbe(const FrameContext& frame, ImpactProbe& outProbe) const;
+
+    // Check 6 - finds the target nearest the impact point and stores it
+    bool FindTargetAtImpact(const FrameContext& frame, const ImpactProbe& probe, const RaycastResult& rayResult);
+
+    // Scheduled detection check - re-validates flight state, since it may run a few frames after the request
+    // Submits the impact ray as a deferred query; PollImpactQuery picks the result up next tick
+    void RunScheduledCheck(const FrameContext& frame);
+
+    // Finish a deferred impact check once its ray has been resolved
+    void PollImpactQuery(const FrameContext& frame);
+
+    // Drop any impact ray still in flight
+    void CancelImpactQuery();
+
+    // Get normalized velocity direction from the frame's character controller velocity
+    bool GetVelocityDirection(const FrameContext& frame, RE::NiPoint3& outDirection) const;
 
     // Get HMD forward direction
-    bool GetHMDForward(RE::NiPoint3& outForward) const;
+    bool GetHMDForward(const FrameContext& frame, RE::NiPoint3& outForward) const;
 
     // Check if two directions are aligned within angle threshold
     bool AreDirectionsAligned(const RE::NiPoint3& dir1, const RE::NiPoint3& dir2, float maxAngleDegrees) const;
@@ -82,6 +107,10 @@ private:
     std::chrono::steady_clock::time_point m_slowMotionStartTime;
     std::chrono::steady_clock::time_point m_hitTime;  // When target was hit
 
+    // Deferred impact ray and the probe it was cast from
+    Raycast::QueryTicket m_impactTicket = Raycast::kInvalidTicket;
+    ImpactProbe m_pendingImpact;
+
     // The actor that triggered slow-motion (stored as handle for safety)
     RE::ActorHandle m_targetActorHandle;
 
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+
+// Fixed-timestep accumulator
+// Frame time is banked and paid out in whole steps of 1/rate seconds, so a simulation advanced with
+// it sees the same step size regardless of frame pacing. The leftover fraction of a step is exposed
+// as an interpolation factor for rendering between the last two simulated states.
+class FixedTimestep
+{
+public:
+    // Bank frameDeltaTime and return how many steps to run this frame
+    // At most maxSteps are paid out; time beyond that is dropped so a hitch doesn't snowball
+    int Advance(float frameDeltaTime, int rate, int maxSteps)
+    {
+        m_stepTime = 1.0f / static_cast<float>((std::max)(rate, 1));
+        m_accumulator += (std::max)(frameDeltaTime, 0.0f);
+
+        int steps = 0;
+        while (m_accumulator >= m_stepTime && steps < maxSteps) {
+            m_accumulator -= m_stepTime;
+            steps++;
+        }
+
+        if (m_accumulator >= m_stepTime) {
+            m_accumulator = 0.0f;  // Too far behind - drop the backlog instead of catching up
+        }
+
+        return steps;
+    }
+
+    // Length of one step (seconds) as of the last Advance
+    float GetStepTime() const { return m_stepTime; }
+
+    // How far into the next step the banked time reaches (0-1)
+    float GetAlpha() const { return (std::clamp)(m_accumulator / m_stepTime, 0.0f, 1.0f); }
+
+    void Reset() { m_accumulator = 0.0f; }
+
+private:
+    float m_accumulator = 0.0f;
+    float m_stepTime = 1.0f / 90.0f;
+};
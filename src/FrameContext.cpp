@@ -0,0 +1,69 @@
+#include "FrameContext.h"
+#include "ClimbManager.h"
+#include "util/HavokQueryBackend.h"
+#include "util/Raycast.h"
+
+static FrameContext s_frame;
+
+// Set only while the frame update runs
+static const FrameContext* s_currentFrame = nullptr;
+
+const FrameContext& FrameContext::Begin(uint32_t frameNumber, float deltaTime)
+{
+    FrameContext& frame = s_frame;
+    frame = FrameContext{};
+    frame.frameNumber = frameNumber;
+    frame.deltaTime = deltaTime;
+
+    frame.player = RE::PlayerCharacter::GetSingleton();
+    if (frame.player) {
+        frame.playerPosition = frame.player->GetPosition();
+        frame.controller = frame.player->GetCharController();
+        if (frame.player->parentCell) {
+            frame.physicsWorld = frame.player->parentCell->GetbhkWorld();
+        }
+    }
+
+    if (frame.controller) {
+        RE::hkVector4 velocity;
+        frame.controller->GetLinearVelocityImpl(velocity);
+        frame.havokVelocity = { velocity.quad.m128_f32[0], velocity.quad.m128_f32[1], velocity.quad.m128_f32[2] };
+    }
+
+    frame.havokWorldScale = RE::bhkWorld::GetWorldScale();
+    frame.isBeastForm = ClimbManager::IsPlayerInBeastForm();
+
+    // One lookup of the VR node data for all three nodes
+    if (auto* vrData = frame.player ? frame.player->GetVRNodeData() : nullptr) {
+        if (vrData->UprightHmdNode) {
+            frame.hmd = vrData->UprightHmdNode->world;
+            frame.hasHmd = true;
+        }
+        if (vrData->LeftWandNode) {
+            frame.leftHand = vrData->LeftWandNode->world;
+            frame.hasLeftHand = true;
+        }
+        if (vrData->RightWandNode) {
+            frame.rightHand = vrData->RightWandNode->world;
+            frame.hasRightHand = true;
+        }
+    }
+
+    // Raycasts issued during the update can skip the player -> cell -> world lookup
+    HavokQueryBackend::GetSingleton()->BeginFrameWorld(frame.physicsWorld, frame.havokWorldScale);
+
+    s_currentFrame = &frame;
+    return frame;
+}
+
+void FrameContext::End()
+{
+    HavokQueryBackend::GetSingleton()->EndFrameWorld();
+    Raycast::EndFrame();
+    s_currentFrame = nullptr;
+}
+
+const FrameContext* FrameContext::GetCurrent()
+{
+    return s_currentFrame;
+}
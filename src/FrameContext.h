@@ -0,0 +1,49 @@
+#pragma once
+
+#include "RE/Skyrim.h"
+
+// Engine state captured once at the top of ClimbManager::OnMainThreadUpdate
+// The managers updated from there read it instead of each re-fetching the player, character
+// controller, physics world and VR nodes. Transforms and velocity are copies taken at capture;
+// the pointers are valid for the rest of the frame update and must not be kept across frames.
+struct FrameContext
+{
+    uint32_t frameNumber = 0;  // Rendered frames since load
+    float deltaTime = 0.0f;    // Frame time (seconds, clamped)
+
+    RE::PlayerCharacter* player = nullptr;
+    RE::bhkCharacterController* controller = nullptr;  // nullptr if there is no player or controller
+    RE::bhkWorld* physicsWorld = nullptr;              // Physics world of the player's cell
+    float havokWorldScale = 0.0f;                      // Game units -> Havok units
+    bool isBeastForm = false;
+
+    RE::NiPoint3 playerPosition;  // Feet
+    RE::NiPoint3 havokVelocity;   // Character controller linear velocity (Havok units/s)
+
+    // World transforms of the VR nodes (only valid when the matching has* flag is set)
+    bool hasHmd = false;
+    bool hasLeftHand = false;
+    bool hasRightHand = false;
+    RE::NiTransform hmd;
+    RE::NiTransform leftHand;
+    RE::NiTransform rightHand;
+
+    bool HasHand(bool isLeft) const { return isLeft ? hasLeftHand : hasRightHand; }
+    const RE::NiTransform& GetHand(bool isLeft) const { return isLeft ? leftHand : rightHand; }
+
+    // HMD forward (Y axis of its rotation) - only meaningful when hasHmd is set
+    RE::NiPoint3 GetHmdForward() const
+    {
+        return { hmd.rotate.entry[0][1], hmd.rotate.entry[1][1], hmd.rotate.entry[2][1] };
+    }
+
+    // Capture this frame's state and make it current. Main thread, top of the frame update.
+    static const FrameContext& Begin(uint32_t frameNumber, float deltaTime);
+
+    // End of the frame update - GetCurrent returns nullptr until the next Begin
+    static void End();
+
+    // This frame's state while the frame update runs; nullptr outside it (the physics pre-step,
+    // input handlers), where callers look the state up themselves
+    static const FrameContext* GetCurrent();
+};
@@ -0,0 +1,84 @@
+#include "GrabReadinessTracker.h"
+#include "ClimbSurfaceDetector.h"
+#include "Config.h"
+#include <algorithm>
+#include <cmath>
+
+static float Distance(const RE::NiPoint3& a, const RE::NiPoint3& b)
+{
+    RE::NiPoint3 d = a - b;
+    return std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+}
+
+bool GrabReadinessTracker::IsStale(const FrameContext& frame, bool isLeft) const
+{
+    const HandState& hand = m_hands[isLeft ? 0 : 1];
+    if (!hand.valid || !frame.HasHand(isLeft)) {
+        return true;
+    }
+
+    // Reach changes with beast form and flight
+    if (ClimbSurfaceDetector::GetGrabReach(frame) != hand.reach) {
+        return true;
+    }
+
+    if (frame.frameNumber - hand.frameNumber > MAX_CACHE_FRAMES) {
+        return true;
+    }
+
+    float moved = Distance(frame.GetHand(isLeft).translate, hand.handPosition);
+    if (frame.hasHmd) {
+        moved = (std::max)(moved, Distance(frame.hmd.translate, hand.hmdPosition));
+    }
+    return moved > hand.margin + MOVE_TOLERANCE;
+}
+
+bool GrabReadinessTracker::NeedsRefresh(const FrameContext& frame, bool isLeft) const
+{
+    if (!IsStale(frame, isLeft)) {
+        return false;
+    }
+
+    // Reduced rate: a stale hand is re-checked at most every grabReadinessInterval frames
+    const HandState& hand = m_hands[isLeft ? 0 : 1];
+    uint32_t interval = static_cast<uint32_t>((std::max)(Config::options.grabReadinessInterval, 1));
+    return !hand.valid || frame.frameNumber - hand.frameNumber >= interval;
+}
+
+bool GrabReadinessTracker::Refresh(const FrameContext& frame, bool isLeft)
+{
+    HandState& hand = m_hands[isLeft ? 0 : 1];
+
+    hand.ready = ClimbSurfaceDetector::FindGrabContact(frame, isLeft, hand.contact, hand.margin);
+    hand.contactRef = hand.contact.hitRef ? hand.contact.hitRef->GetHandle() : RE::ObjectRefHandle{};
+    hand.contact.hitRef = nullptr;  // The reference can unload while the answer is cached
+    hand.reach = ClimbSurfaceDetector::GetGrabReach(frame);
+    hand.handPosition = frame.HasHand(isLeft) ? frame.GetHand(isLeft).translate : RE::NiPoint3{ 0.0f, 0.0f, 0.0f };
+    hand.hmdPosition = frame.hasHmd ? frame.hmd.translate : RE::NiPoint3{ 0.0f, 0.0f, 0.0f };
+    hand.frameNumber = frame.frameNumber;
+    hand.valid = frame.HasHand(isLeft);
+
+    return hand.ready;
+}
+
+bool GrabReadinessTracker::TryGetCached(const FrameContext& frame, bool isLeft, bool& outReady) const
+{
+    if (IsStale(frame, isLeft)) {
+        return false;
+    }
+
+    outReady = m_hands[isLeft ? 0 : 1].ready;
+    return true;
+}
+
+bool GrabReadinessTracker::GetCachedContact(bool isLeft, RaycastResult& outContact) const
+{
+    const HandState& hand = m_hands[isLeft ? 0 : 1];
+    if (!hand.valid || !hand.ready) {
+        return false;
+    }
+
+    outContact = hand.contact;
+    outContact.hitRef = hand.contactRef.get().get();
+    return true;
+}
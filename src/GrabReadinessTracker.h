@@ -0,0 +1,54 @@
+#pragma once
+
+#include "RE/Skyrim.h"
+#include "FrameContext.h"
+#include "util/Raycast.h"
+#include <cstdint>
+
+// Per-hand cache of "would a grip press grab a surface right now" (ClimbSurfaceDetector::FindGrabContact)
+// Each check also measures a margin: how far the hand and HMD can move before its answer can change (the
+// reach left to the contact, or the gap to the nearest surface on a miss, at most a quarter of the reach).
+// Until they move that far the cached answer stands, so a still hand isn't probed at all and one closing in
+// on a wall is re-checked more often the nearer it gets - in the background at most every
+// Config::options.grabReadinessInterval frames, so the grip consumption snapshot is current before a press.
+// A grip press reads the cache and only runs the check itself when it is stale.
+class GrabReadinessTracker
+{
+public:
+    // Answers older than this are re-checked regardless of movement (moving platforms, doors)
+    static constexpr uint32_t MAX_CACHE_FRAMES = 45;
+
+    // Movement every answer survives on top of its margin, so tracking jitter doesn't expire it (game units)
+    static constexpr float MOVE_TOLERANCE = 0.5f;
+
+    // Whether a hand's cached answer is out of date and due a background refresh at the reduced rate
+    bool NeedsRefresh(const FrameContext& frame, bool isLeft) const;
+
+    // Run the grab check for a hand now and cache it - returns whether the hand can grab
+    bool Refresh(const FrameContext& frame, bool isLeft);
+
+    // Cached answer if it still holds for this frame's hand and HMD positions
+    // Returns false when stale - call Refresh (the synchronous check) instead
+    bool TryGetCached(const FrameContext& frame, bool isLeft, bool& outReady) const;
+
+    // Contact the last cached answer grabs - false if it wasn't ready
+    // Its hitRef is looked up again, so it is nullptr if the object went away since the check
+    bool GetCachedContact(bool isLeft, RaycastResult& outContact) const;
+
+private:
+    struct HandState {
+        bool valid = false;
+        bool ready = false;
+        RaycastResult contact{};     // Nearest contact (only meaningful when ready) - hitRef kept in contactRef
+        RE::ObjectRefHandle contactRef;
+        float margin = 0.0f;         // Movement the answer survives (game units)
+        float reach = 0.0f;          // Grab reach the answer was made with
+        RE::NiPoint3 handPosition;   // Hand and HMD positions at the check
+        RE::NiPoint3 hmdPosition;
+        uint32_t frameNumber = 0;    // Frame of the check
+    };
+
+    bool IsStale(const FrameContext& frame, bool isLeft) const;
+
+    HandState m_hands[2];  // Left=0, Right=1
+};
@@ -0,0 +1,357 @@
+#include "HandPosePredictor.h"
+#include "InputManager.h"
+#include "Config.h"
+#include "util/VRNodes.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+// A frame this long is a hitch or a pause - the history no longer describes the hand's motion
+static constexpr float MAX_SAMPLE_GAP = 0.1f;
+
+// Below this the hand counts as still (game units/s)
+static constexpr float MIN_PREDICTION_SPEED = 1.0f;
+
+// Rotations smaller than this per frame aren't extrapolated (radians)
+static constexpr float MIN_PREDICTION_ROTATION = 0.0005f;
+
+// Game units per meter when fVrScale:VR can't be read (the game's default)
+static constexpr float DEFAULT_VR_SCALE = 70.0f;
+
+static float Length(const RE::NiPoint3& v)
+{
+    return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+static float Dot(const RE::NiPoint3& a, const RE::NiPoint3& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// NiMatrix3 is row-major and applied to column vectors: world = parent.rotate * local
+static RE::NiPoint3 Rotate(const RE::NiMatrix3& m, const RE::NiPoint3& v)
+{
+    return {
+        m.entry[0][0] * v.x + m.entry[0][1] * v.y + m.entry[0][2] * v.z,
+        m.entry[1][0] * v.x + m.entry[1][1] * v.y + m.entry[1][2] * v.z,
+        m.entry[2][0] * v.x + m.entry[2][1] * v.y + m.entry[2][2] * v.z
+    };
+}
+
+static RE::NiMatrix3 Multiply(const RE::NiMatrix3& a, const RE::NiMatrix3& b)
+{
+    RE::NiMatrix3 result;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            result.entry[row][col] = a.entry[row][0] * b.entry[0][col] + a.entry[row][1] * b.entry[1][col] + a.entry[row][2] * b.entry[2][col];
+        }
+    }
+    return result;
+}
+
+// a * transpose(b) - for rotations, the rotation that takes b to a
+static RE::NiMatrix3 MultiplyTransposed(const RE::NiMatrix3& a, const RE::NiMatrix3& b)
+{
+    RE::NiMatrix3 result;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            result.entry[row][col] = a.entry[row][0] * b.entry[col][0] + a.entry[row][1] * b.entry[col][1] + a.entry[row][2] * b.entry[col][2];
+        }
+    }
+    return result;
+}
+
+// Angle (radians) and unit axis of a rotation matrix; returns 0 for (near) identity
+static float ToAxisAngle(const RE::NiMatrix3& m, RE::NiPoint3& outAxis)
+{
+    float cosAngle = std::clamp((m.entry[0][0] + m.entry[1][1] + m.entry[2][2] - 1.0f) * 0.5f, -1.0f, 1.0f);
+    float angle = std::acos(cosAngle);
+
+    RE::NiPoint3 axis = {
+        m.entry[2][1] - m.entry[1][2],
+        m.entry[0][2] - m.entry[2][0],
+        m.entry[1][0] - m.entry[0][1]
+    };
+    float axisLength = Length(axis);  // 2 * sin(angle)
+    if (axisLength < 1e-6f) {
+        return 0.0f;  // No rotation, or a half turn - neither happens between two tracked frames
+    }
+
+    outAxis = axis * (1.0f / axisLength);
+    return angle;
+}
+
+// Rotation of angle radians around a unit axis (Rodrigues)
+static RE::NiMatrix3 FromAxisAngle(const RE::NiPoint3& axis, float angle)
+{
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    float t = 1.0f - c;
+
+    RE::NiMatrix3 m;
+    m.entry[0][0] = t * axis.x * axis.x + c;
+    m.entry[0][1] = t * axis.x * axis.y - s * axis.z;
+    m.entry[0][2] = t * axis.x * axis.z + s * axis.y;
+    m.entry[1][0] = t * axis.x * axis.y + s * axis.z;
+    m.entry[1][1] = t * axis.y * axis.y + c;
+    m.entry[1][2] = t * axis.y * axis.z - s * axis.x;
+    m.entry[2][0] = t * axis.x * axis.z - s * axis.y;
+    m.entry[2][1] = t * axis.y * axis.z + s * axis.x;
+    m.entry[2][2] = t * axis.z * axis.z + c;
+    return m;
+}
+
+static float GetVrScale()
+{
+    // Game units per meter of tracked movement
+    auto* setting = RE::GetINISetting("fVrScale:VR");
+    if (setting && setting->GetType() == RE::Setting::Type::kFloat && setting->GetFloat() > 0.0f) {
+        return setting->GetFloat();
+    }
+    return DEFAULT_VR_SCALE;
+}
+
+void HandPosePredictor::Update(const FrameContext& frame)
+{
+    if (Config::options.handPredictionEnabled || Config::options.trackedLaunchVelocityWeight > 0.0f) {
+        SampleTrackedVelocities();
+    } else {
+        for (auto& hand : m_hands) {
+            hand.hasTrackedVelocity = false;
+        }
+    }
+
+    if (!Config::options.handPredictionEnabled) {
+        Reset();
+        return;
+    }
+
+    if (frame.deltaTime <= 0.0f || frame.deltaTime >= MAX_SAMPLE_GAP) {
+        Reset();
+    }
+
+    m_predictionTime = ResolvePredictionTime(frame.deltaTime);
+
+    UpdateHand(m_hands[0], VRNodes::GetLeftHand(), frame.deltaTime);
+    UpdateHand(m_hands[1], VRNodes::GetRightHand(), frame.deltaTime);
+}
+
+void HandPosePredictor::Reset()
+{
+    for (auto& hand : m_hands) {
+        hand.count = 0;
+        hand.hasPrediction = false;
+    }
+}
+
+bool HandPosePredictor::GetPredictedTransform(bool isLeft, RE::NiTransform& outTransform) const
+{
+    const HandState& hand = m_hands[isLeft ? 0 : 1];
+    if (!hand.hasPrediction) {
+        return false;
+    }
+    outTransform = hand.predicted;
+    return true;
+}
+
+bool HandPosePredictor::GetPredictedPosition(bool isLeft, RE::NiPoint3& outPosition) const
+{
+    const HandState& hand = m_hands[isLeft ? 0 : 1];
+    if (!hand.hasPrediction) {
+        return false;
+    }
+    outPosition = hand.predicted.translate;
+    return true;
+}
+
+bool HandPosePredictor::GetTrackedVelocity(bool isLeft, RE::NiPoint3& outVelocity) const
+{
+    const HandState& hand = m_hands[isLeft ? 0 : 1];
+    if (!hand.hasTrackedVelocity) {
+        return false;
+    }
+    outVelocity = hand.trackedWorldVelocity;
+    return true;
+}
+
+void HandPosePredictor::SampleTrackedVelocities()
+{
+    for (auto& hand : m_hands) {
+        hand.hasTrackedVelocity = false;
+    }
+
+    vr::IVRSystem* vrSystem = InputManager::GetSingleton()->GetVRSystem();
+    if (!vrSystem) {
+        return;  // No SkyrimVRTools - the history alone drives the prediction
+    }
+
+    vr::TrackedDevicePose_t poses[vr::k_unMaxTrackedDeviceCount];
+    vrSystem->GetDeviceToAbsoluteTrackingPose(vr::TrackingUniverseStanding, 0.0f, poses, vr::k_unMaxTrackedDeviceCount);
+
+    float unitsPerMeter = GetVrScale();
+    for (int i = 0; i < 2; ++i) {
+        auto role = i == 0 ? vr::TrackedControllerRole_LeftHand : vr::TrackedControllerRole_RightHand;
+        vr::TrackedDeviceIndex_t index = vrSystem->GetTrackedDeviceIndexForControllerRole(role);
+        if (index >= vr::k_unMaxTrackedDeviceCount) {
+            continue;
+        }
+
+        const vr::TrackedDevicePose_t& pose = poses[index];
+        if (!pose.bPoseIsValid || pose.eTrackingResult != vr::TrackingResult_Running_OK) {
+            continue;  // Occluded or out of range - OpenVR is guessing, the history is the better source
+        }
+
+        // Tracking space is Y up, -Z forward, meters; the room the wands sit in is Z up, +Y forward, game units
+        HandState& hand = m_hands[i];
+        const float* velocity = pose.vVelocity.v;
+        hand.trackedVelocity = { velocity[0] * unitsPerMeter, -velocity[2] * unitsPerMeter, velocity[1] * unitsPerMeter };
+        const auto& pose34 = pose.mDeviceToAbsoluteTracking.m;
+        hand.trackedPosition = { pose34[0][3] * unitsPerMeter, -pose34[2][3] * unitsPerMeter, pose34[1][3] * unitsPerMeter };
+
+        // The room turns with the player (snap/smooth turn) - rotate onto world axes the way the wand is placed
+        RE::NiAVObject* node = i == 0 ? VRNodes::GetLeftHand() : VRNodes::GetRightHand();
+        if (node && node->parent) {
+            const RE::NiTransform& room = node->parent->world;
+            hand.trackedWorldVelocity = Rotate(room.rotate, hand.trackedVelocity * room.scale);
+        } else {
+            hand.trackedWorldVelocity = hand.trackedVelocity;
+        }
+        hand.hasTrackedVelocity = true;
+    }
+}
+
+void HandPosePredictor::SampleStepMovement()
+{
+    SampleTrackedVelocities();
+
+    for (int i = 0; i < 2; ++i) {
+        HandState& hand = m_hands[i];
+        hand.hasStepMovement = false;
+        if (!hand.hasTrackedVelocity) {
+            hand.hasStepReference = false;
+            continue;
+        }
+
+        if (hand.hasStepReference) {
+            RE::NiPoint3 movement = hand.trackedPosition - hand.stepReference;
+            RE::NiAVObject* node = i == 0 ? VRNodes::GetLeftHand() : VRNodes::GetRightHand();
+            if (node && node->parent) {
+                const RE::NiTransform& room = node->parent->world;
+                hand.stepMovement = Rotate(room.rotate, movement * room.scale);
+            } else {
+                hand.stepMovement = movement;
+            }
+            hand.hasStepMovement = true;
+        }
+        hand.stepReference = hand.trackedPosition;
+        hand.hasStepReference = true;
+    }
+}
+
+bool HandPosePredictor::GetStepMovement(bool isLeft, RE::NiPoint3& outWorldDelta) const
+{
+    const HandState& hand = m_hands[isLeft ? 0 : 1];
+    if (!hand.hasStepMovement) {
+        return false;
+    }
+    outWorldDelta = hand.stepMovement;
+    return true;
+}
+
+void HandPosePredictor::UpdateHand(HandState& hand, RE::NiAVObject* node, float deltaTime)
+{
+    hand.hasPrediction = false;
+    if (!node) {
+        hand.count = 0;
+        return;
+    }
+
+    // Room-space pose - player movement (including the movement climbing applies) moves the room, not this
+    hand.head = (hand.head + 1) % HISTORY_SIZE;
+    Sample& sample = hand.history[hand.head];
+    sample.position = node->local.translate;
+    sample.rotate = node->local.rotate;
+    sample.deltaTime = deltaTime;
+    hand.count = (std::min)(hand.count + 1, HISTORY_SIZE);
+
+    if (hand.count < 3 || m_predictionTime <= 0.0f) {
+        return;
+    }
+
+    const Sample& newest = hand.Newest(0);
+    const Sample& previous = hand.Newest(1);
+    const Sample& older = hand.Newest(2);
+    float lastDeltaTime = newest.deltaTime;
+    float spanDeltaTime = newest.deltaTime + previous.deltaTime;
+    if (lastDeltaTime <= 0.0f) {
+        return;
+    }
+
+    // Velocity from OpenVR if it is tracking the controller, else over the last two frames
+    RE::NiPoint3 lastVelocity = (newest.position - previous.position) * (1.0f / lastDeltaTime);
+    RE::NiPoint3 velocity = hand.hasTrackedVelocity ? hand.trackedVelocity
+                                                    : (newest.position - older.position) * (1.0f / spanDeltaTime);
+
+    RE::NiPoint3 predictedPosition = newest.position;
+    float speed = Length(velocity);
+    float lastSpeed = Length(lastVelocity);
+    if (speed >= MIN_PREDICTION_SPEED && Dot(velocity, lastVelocity) > 0.0f) {
+        // A stopping hand moved less last frame than the estimate says - don't carry it past where it stops
+        if (speed > lastSpeed) {
+            velocity = velocity * (lastSpeed / speed);
+        }
+
+        RE::NiPoint3 offset = velocity * m_predictionTime;
+        float distance = Length(offset);
+        float maxDistance = (std::max)(Config::options.handPredictionMaxDistance, 0.0f);
+        if (distance > maxDistance) {
+            offset = offset * (maxDistance / distance);
+        }
+        predictedPosition = newest.position + offset;
+    }
+
+    // Keep turning at last frame's rate, capped
+    RE::NiMatrix3 predictedRotate = newest.rotate;
+    RE::NiPoint3 axis;
+    float frameAngle = ToAxisAngle(MultiplyTransposed(newest.rotate, previous.rotate), axis);
+    if (frameAngle >= MIN_PREDICTION_ROTATION) {
+        float angle = (std::min)(frameAngle * (m_predictionTime / lastDeltaTime), MAX_PREDICTION_ANGLE);
+        predictedRotate = Multiply(FromAxisAngle(axis, angle), newest.rotate);
+    }
+
+    // Back to world space through the room, as the game places the wand
+    RE::NiAVObject* parent = node->parent;
+    if (parent) {
+        const RE::NiTransform& room = parent->world;
+        hand.predicted.rotate = Multiply(room.rotate, predictedRotate);
+        hand.predicted.translate = room.translate + Rotate(room.rotate, predictedPosition * room.scale);
+    } else {
+        hand.predicted.rotate = predictedRotate;
+        hand.predicted.translate = predictedPosition;
+    }
+    hand.predicted.scale = node->world.scale;
+    hand.hasPrediction = true;
+}
+
+float HandPosePredictor::ResolvePredictionTime(float deltaTime)
+{
+    float predictionTime = Config::options.handPredictionTime;
+    if (predictionTime <= 0.0f) {
+        // One display frame - the age of the wand poses when the climbing update reads them
+        if (!m_displayLookupDone) {
+            if (vr::IVRSystem* vrSystem = InputManager::GetSingleton()->GetVRSystem()) {
+                vr::ETrackedPropertyError error = vr::TrackedProp_Success;
+                float refreshRate = vrSystem->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd,
+                    vr::Prop_DisplayFrequency_Float, &error);
+                if (error == vr::TrackedProp_Success && refreshRate > 0.0f) {
+                    m_displayFrameTime = 1.0f / refreshRate;
+                    spdlog::info("HandPosePredictor: Predicting {:.1f} ms ahead ({:.0f} Hz display)",
+                        m_displayFrameTime * 1000.0f, refreshRate);
+                }
+                m_displayLookupDone = true;
+            }
+        }
+        predictionTime = m_displayFrameTime > 0.0f ? m_displayFrameTime : deltaTime;
+    }
+    return std::clamp(predictionTime, 0.0f, MAX_PREDICTION_TIME);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "RE/Skyrim.h"
+#include "FrameContext.h"
+#include <cstddef>
+
+// Extrapolates the VR wand poses to the time the frame is displayed (Config::options.handPredictionEnabled)
+// The wand node transforms the climbing update reads were sampled a frame earlier, so the body follows
+// the arms a frame late. Each hand keeps a short history of its room-space pose (the wand's local
+// transform, unaffected by the player moving); velocity comes from OpenVR's controller pose when it is
+// tracking and from the history otherwise. The prediction is limited so it doesn't overshoot when the
+// hand stops or turns around: it never runs ahead of the latest frame's speed, is dropped when the hand
+// reverses, and is capped in distance and angle.
+// Over a pull the prediction cancels out (a hand at rest is predicted where it is), so climbing from the
+// predicted poses moves the player just as far, only earlier.
+// The OpenVR controller velocities are also what launches blend in (Config::options.trackedLaunchVelocityWeight).
+class HandPosePredictor
+{
+public:
+    static constexpr size_t HISTORY_SIZE = 4;           // Frames of pose history per hand
+    static constexpr float MAX_PREDICTION_TIME = 0.05f; // Upper bound on the prediction horizon (seconds)
+    static constexpr float MAX_PREDICTION_ANGLE = 0.26f; // Max predicted rotation (radians, ~15 degrees)
+
+    // Main thread, once per frame right after FrameContext::Begin
+    void Update(const FrameContext& frame);
+
+    // Drop the history (prediction restarts after a few frames)
+    void Reset();
+
+    // Re-read the controller velocities from OpenVR - Update does this once per frame while prediction or
+    // tracked launch velocity is on; call it to get the latest IMU-fused velocity mid-frame (e.g. at release)
+    void SampleTrackedVelocities();
+
+    // Controller velocity from OpenVR, world axes, game units/s, relative to the player (room) - false if
+    // OpenVR isn't tracking the controller or wasn't sampled this frame
+    bool GetTrackedVelocity(bool isLeft, RE::NiPoint3& outVelocity) const;
+
+    // Physics-step climbing runs several steps per frame but the wand nodes only update once. Each call
+    // re-reads the controller poses from OpenVR and measures how far they moved since the previous call;
+    // GetStepMovement returns that movement on world axes (game units), false if OpenVR wasn't tracking the
+    // controller at both calls. Call it once on the step that samples the nodes to start measuring from there.
+    void SampleStepMovement();
+    bool GetStepMovement(bool isLeft, RE::NiPoint3& outWorldDelta) const;
+
+    // Predicted world transform/position of a wand for this frame
+    // Returns false when there is no prediction (disabled, hand not tracked, history still filling)
+    bool GetPredictedTransform(bool isLeft, RE::NiTransform& outTransform) const;
+    bool GetPredictedPosition(bool isLeft, RE::NiPoint3& outPosition) const;
+
+    // Horizon used for this frame's prediction (seconds)
+    float GetPredictionTime() const { return m_predictionTime; }
+
+private:
+    struct Sample {
+        RE::NiPoint3 position;  // Wand local (room space) translate
+        RE::NiMatrix3 rotate;   // Wand local rotate
+        float deltaTime = 0.0f; // Time since the previous sample
+    };
+
+    struct HandState {
+        Sample history[HISTORY_SIZE];
+        size_t head = 0;   // Slot of the newest sample
+        size_t count = 0;
+
+        bool hasPrediction = false;
+        RE::NiTransform predicted;  // World space
+
+        // Controller velocity reported by OpenVR this frame (game units/s) in room space and on world axes,
+        // and the position it was reported at (room space)
+        bool hasTrackedVelocity = false;
+        RE::NiPoint3 trackedVelocity;
+        RE::NiPoint3 trackedWorldVelocity;
+        RE::NiPoint3 trackedPosition;
+
+        // SampleStepMovement: position at the previous call (room space) and the movement since, on world axes
+        bool hasStepReference = false;
+        RE::NiPoint3 stepReference;
+        bool hasStepMovement = false;
+        RE::NiPoint3 stepMovement;
+
+        const Sample& Newest(size_t age) const { return history[(head + HISTORY_SIZE - age) % HISTORY_SIZE]; }
+    };
+
+    void UpdateHand(HandState& hand, RE::NiAVObject* node, float deltaTime);
+    float ResolvePredictionTime(float deltaTime);
+
+    HandState m_hands[2];  // Left=0, Right=1
+    float m_predictionTime = 0.0f;
+    float m_displayFrameTime = 0.0f;  // 1 / HMD refresh rate, looked up once from OpenVR (0 = unknown)
+    bool m_displayLookupDone = false;
+};
@@ -1,5 +1,6 @@
 #include "HiggsCompatManager.h"
 #include "higgsinterface001.h"
+#include "util/TickRegistry.h"
 #include <spdlog/spdlog.h>
 #include <string>
 
@@ -103,11 +104,14 @@ void HiggsCompatManager::RestoreGravityGloves()
     m_restorePending = true;
     m_restoreRequestId = m_disableRequestCounter;
     m_restoreRequestTime = std::chrono::steady_clock::now();
+    TickRegistry::Subscribe(TickRegistry::Tick::kHiggsRestore);
 }
 
 void HiggsCompatManager::Update()
 {
     if (!m_restorePending) {
+        // Nothing scheduled (restored, or cancelled by a new disable) - idle until the next restore
+        TickRegistry::Unsubscribe(TickRegistry::Tick::kHiggsRestore);
         return;
     }
 
@@ -4,6 +4,11 @@
 
 uint64_t InputManager::s_lastButtonState[2] = {0, 0};
 uint64_t InputManager::s_blockedHeldButtons[2] = {0, 0};
+std::atomic<bool> InputManager::s_eventsDropped{false};
+std::atomic<uint64_t> InputManager::s_heldButtons[2] = {0, 0};
+std::atomic<uint64_t> InputManager::s_consumeOnPress[2] = {0, 0};
+std::atomic<uint64_t> InputManager::s_lateBlock[2] = {0, 0};
+std::atomic<uint64_t> InputManager::s_lateUnblock[2] = {0, 0};
 
 InputManager* InputManager::GetSingleton()
 {
@@ -54,6 +59,11 @@ void InputManager::Shutdown()
 	m_initialized = false;
 	s_blockedHeldButtons[0] = 0;
 	s_blockedHeldButtons[1] = 0;
+	for (int i = 0; i < 2; ++i) {
+		s_consumeOnPress[i].store(0);
+		s_lateBlock[i].store(0);
+		s_lateUnblock[i].store(0);
+	}
 	spdlog::info("InputManager shut down");
 }
 
@@ -80,6 +90,74 @@ void InputManager::RemoveVrButtonCallback(CallbackId id)
 	}
 }
 
+void InputManager::SetConsumeOnPress(bool isLeft, uint64_t buttonMask, bool consume)
+{
+	auto& consumeMask = s_consumeOnPress[isLeft ? 0 : 1];
+	if (consume) {
+		consumeMask.fetch_or(buttonMask, std::memory_order_relaxed);
+	} else {
+		consumeMask.fetch_and(~buttonMask, std::memory_order_relaxed);
+	}
+}
+
+void InputManager::ProcessButtonEvents()
+{
+	ButtonEvent event;
+	while (m_eventQueue.TryPop(event)) {
+		DeliverButtonEvent(event);
+	}
+
+	// Edges were lost while the queue was full (e.g. main thread stalled on a load screen)
+	// Deliver the difference between the last delivered state and the current raw state instead,
+	// so a lost release can't leave a hand climbing
+	if (s_eventsDropped.exchange(false, std::memory_order_acquire)) {
+		spdlog::warn("InputManager: Button event queue overflowed - resyncing from current button state");
+		for (int handIndex = 0; handIndex < 2; ++handIndex) {
+			uint64_t held = s_heldButtons[handIndex].load(std::memory_order_acquire);
+			ButtonEvent resync;
+			resync.timestamp = std::chrono::steady_clock::now();
+			resync.pressed = held & ~m_deliveredButtons[handIndex];
+			resync.released = m_deliveredButtons[handIndex] & ~held;
+			resync.handIndex = handIndex;
+			DeliverButtonEvent(resync);
+		}
+	}
+}
+
+void InputManager::DeliverButtonEvent(const ButtonEvent& event)
+{
+	bool isLeft = event.handIndex == 0;
+	uint64_t& delivered = m_deliveredButtons[event.handIndex];
+
+	spdlog::trace("InputManager: Delivering {} hand edges (pressed 0x{:X}, released 0x{:X}) {:.2f} ms after input",
+		isLeft ? "left" : "right", event.pressed, event.released,
+		std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - event.timestamp).count());
+
+	// Only deliver real transitions - a resync may already have delivered an edge that was still queued
+	uint64_t pressed = event.pressed & ~delivered;
+	if (pressed) {
+		delivered |= pressed;
+		uint64_t consumed = InvokeCallbacks(isLeft, false, pressed);
+
+		// The hook decided from the consume snapshot - correct it where the callbacks disagree
+		// (only applied while the button is still held, so a stale correction can't block a later press)
+		uint64_t lateBlock = consumed & ~event.blocked;
+		uint64_t lateUnblock = pressed & event.blocked & ~consumed;
+		if (lateBlock) {
+			s_lateBlock[event.handIndex].fetch_or(lateBlock, std::memory_order_release);
+		}
+		if (lateUnblock) {
+			s_lateUnblock[event.handIndex].fetch_or(lateUnblock, std::memory_order_release);
+		}
+	}
+
+	uint64_t released = event.released & delivered;
+	if (released) {
+		delivered &= ~released;
+		InvokeCallbacks(isLeft, true, released);
+	}
+}
+
 uint64_t InputManager::InvokeCallbacks(bool isLeft, bool isReleased, uint64_t changedButtons)
 {
 	uint64_t blockedButtons = 0;
@@ -136,14 +214,11 @@ bool InputManager::OnControllerStateChanged(
 		vr::ETrackedControllerRole::TrackedControllerRole_RightHand);
 
 	int handIndex = -1;
-	bool isLeft = false;
 
 	if (unControllerDeviceIndex == leftController) {
 		handIndex = 0;
-		isLeft = true;
 	} else if (unControllerDeviceIndex == rightController) {
 		handIndex = 1;
-		isLeft = false;
 	}
 
 	if (handIndex < 0) {
@@ -158,15 +233,30 @@ bool InputManager::OnControllerStateChanged(
 	// Detect newly released buttons (bits that were 1 but are now 0)
 	uint64_t newlyReleased = lastButtons & ~currentButtons;
 
-	if (newlyPressed) {
-		uint64_t blocked = instance->InvokeCallbacks(isLeft, false, newlyPressed);
-		s_blockedHeldButtons[handIndex] |= blocked;  // Remember blocked buttons while held
-	}
+	// Apply the main thread's decisions for presses that are still held
+	uint64_t stillHeld = lastButtons & currentButtons;
+	uint64_t lateBlock = s_lateBlock[handIndex].exchange(0, std::memory_order_acquire);
+	uint64_t lateUnblock = s_lateUnblock[handIndex].exchange(0, std::memory_order_acquire);
+	s_blockedHeldButtons[handIndex] |= lateBlock & stillHeld;
+	s_blockedHeldButtons[handIndex] &= ~(lateUnblock & stillHeld);
+
+	// Callbacks run later on the main thread - decide blocking now from the published snapshot only
+	uint64_t blocked = newlyPressed & s_consumeOnPress[handIndex].load(std::memory_order_relaxed);
+	s_blockedHeldButtons[handIndex] |= blocked;  // Remember blocked buttons while held
+	s_blockedHeldButtons[handIndex] &= ~newlyReleased;  // Stop blocking on release
 
-	if (newlyReleased) {
-		instance->InvokeCallbacks(isLeft, true, newlyReleased);
-		s_blockedHeldButtons[handIndex] &= ~newlyReleased;  // Stop blocking on release
+	if (newlyPressed || newlyReleased) {
+		ButtonEvent event;
+		event.timestamp = std::chrono::steady_clock::now();
+		event.pressed = newlyPressed;
+		event.released = newlyReleased;
+		event.blocked = blocked;
+		event.handIndex = handIndex;
+		if (!instance->m_eventQueue.TryPush(event)) {
+			s_eventsDropped.store(true, std::memory_order_release);
+		}
 	}
+	s_heldButtons[handIndex].store(currentButtons, std::memory_order_release);
 
 	// Block consumed buttons from reaching the game - every frame while held
 	if (s_blockedHeldButtons[handIndex] && pOutputControllerState) {
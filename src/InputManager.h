@@ -1,11 +1,15 @@
 #pragma once
 #include "VRHookAPI.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <vector>
 
 class InputManager
 {
 public:
+	// Called on the main thread from ProcessButtonEvents, not on the OpenVR input thread
 	// Return true to consume/block the input, false to let it pass through
 	using VrButtonCallback = std::function<bool(bool isLeft, bool isReleased, vr::EVRButtonId buttonId)>;
 	using CallbackId = uint32_t;
@@ -19,12 +23,24 @@ public:
 	bool IsInitialized() const { return m_initialized; }
 	bool IsSkyrimVRToolsMissing() const { return m_skyrimVRToolsMissing; }
 
+	// OpenVR system interface from SkyrimVRTools (nullptr if it is missing)
+	vr::IVRSystem* GetVRSystem() const { return m_vrSystem; }
+
 	// Register a callback for specific button(s). Returns an ID for removal.
 	CallbackId AddVrButtonCallback(uint64_t buttonMask, VrButtonCallback callback);
 
 	// Remove a callback by its ID
 	void RemoveVrButtonCallback(CallbackId id);
 
+	// Run the callbacks for the button edges queued by the input hook since the last call
+	// Main thread, once per frame
+	void ProcessButtonEvents();
+
+	// Buttons whose presses the input hook blocks right away for this hand
+	// The hook can't run callbacks, so owners publish the consumption they expect here each frame.
+	// If a callback then decides otherwise, the hook follows its decision from the next controller update.
+	void SetConsumeOnPress(bool isLeft, uint64_t buttonMask, bool consume);
+
 private:
 	InputManager() = default;
 	~InputManager() = default;
@@ -37,6 +53,16 @@ private:
 		uint32_t unControllerStateSize,
 		vr::VRControllerState_t* pOutputControllerState);
 
+	// Button edges seen by the input hook in one controller update
+	struct ButtonEvent {
+		std::chrono::steady_clock::time_point timestamp;  // When the hook saw the edges
+		uint64_t pressed = 0;                             // Newly pressed buttons
+		uint64_t released = 0;                            // Newly released buttons
+		uint64_t blocked = 0;                             // Pressed buttons the hook started blocking (consume snapshot)
+		int handIndex = 0;                                // Left=0, Right=1
+	};
+
+	void DeliverButtonEvent(const ButtonEvent& event);
 	uint64_t InvokeCallbacks(bool isLeft, bool isReleased, uint64_t changedButtons);
 	static const char* GetButtonName(uint64_t buttonMask);
 
@@ -53,6 +79,20 @@ private:
 	std::vector<ButtonCallbackEntry> m_callbacks;
 	CallbackId m_nextCallbackId = 1;  // 0 is InvalidCallbackId
 
+	// Main thread: buttons held as far as the delivered events go
+	uint64_t m_deliveredButtons[2] = {0, 0};
+
+	// Input thread -> main thread
+	SpscQueue<ButtonEvent, 64> m_eventQueue;
+	static std::atomic<bool> s_eventsDropped;          // Queue was full - resync from s_heldButtons
+	static std::atomic<uint64_t> s_heldButtons[2];     // Latest raw button state per hand
+
+	// Main thread -> input thread
+	static std::atomic<uint64_t> s_consumeOnPress[2];  // Block these buttons as soon as they are pressed
+	static std::atomic<uint64_t> s_lateBlock[2];       // Callbacks consumed a press the hook let through
+	static std::atomic<uint64_t> s_lateUnblock[2];     // Callbacks passed on a press the hook blocked
+
+	// Input thread only
 	static uint64_t s_lastButtonState[2];     // Left=0, Right=1
 	static uint64_t s_blockedHeldButtons[2];  // Buttons currently blocked while held
 };
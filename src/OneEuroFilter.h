@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+
+// One-Euro adaptive low-pass filter (Casiez et al.), one axis
+// The cutoff frequency rises with the signal's speed: a signal that barely moves is smoothed hard, which
+// removes tracking jitter, while a fast one passes with little lag. The speed is low-passed at its own
+// fixed cutoff so jitter doesn't open the filter up.
+// The output lives with the caller (the climbing player's position): each step returns the factor to move
+// it toward the new sample, 1 - exp(-2*pi*cutoff*dt), the same frame-rate independent form as the
+// exponential smoother.
+class OneEuroFilter
+{
+public:
+    // Take a raw sample and return this step's smoothing factor (0-1)
+    // minCutoff (Hz) applies at rest; beta raises it per unit/s of speed; derivativeCutoff (Hz) smooths the speed
+    float Update(float value, float deltaTime, float minCutoff, float beta, float derivativeCutoff)
+    {
+        if (deltaTime <= 0.0f) {
+            return 0.0f;
+        }
+
+        if (!m_hasPrevious) {
+            m_previous = value;
+            m_derivative = 0.0f;
+            m_hasPrevious = true;
+        }
+
+        float rawDerivative = (value - m_previous) / deltaTime;
+        m_previous = value;
+        m_derivative += (rawDerivative - m_derivative) * SmoothingFactor(derivativeCutoff, deltaTime);
+
+        float cutoff = minCutoff + beta * std::fabs(m_derivative);
+        return SmoothingFactor(cutoff, deltaTime);
+    }
+
+    // Next sample starts from rest
+    void Reset() { m_hasPrevious = false; }
+
+    static float SmoothingFactor(float cutoff, float deltaTime)
+    {
+        constexpr float TWO_PI = 6.28318531f;
+        float factor = 1.0f - std::exp(-TWO_PI * cutoff * deltaTime);
+        return factor < 0.0f ? 0.0f : (factor > 1.0f ? 1.0f : factor);
+    }
+
+private:
+    float m_previous = 0.0f;    // Last raw sample
+    float m_derivative = 0.0f;  // Low-passed rate of change (units/s)
+    bool m_hasPrevious = false;
+};
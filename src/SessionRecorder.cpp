@@ -0,0 +1,173 @@
+#include "SessionRecorder.h"
+#include "ClimbManager.h"
+#include "BallisticController.h"
+#include "ClimbExitCorrector.h"
+#include "Config.h"
+#include "util/Raycast.h"
+#include <spdlog/spdlog.h>
+
+static PhysicsQuery::Vec3 ToVec3(const RE::NiPoint3& p)
+{
+    return { p.x, p.y, p.z };
+}
+
+static SessionStream::Transform ToTransform(const RE::NiTransform& transform)
+{
+    SessionStream::Transform out;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            out.rotate[row][col] = transform.rotate.entry[row][col];
+        }
+    }
+    out.translate = ToVec3(transform.translate);
+    return out;
+}
+
+SessionRecorder* SessionRecorder::GetSingleton()
+{
+    static SessionRecorder instance;
+    return &instance;
+}
+
+bool SessionRecorder::Start()
+{
+    auto logsFolder = SKSE::log::log_directory();
+    if (!logsFolder) {
+        spdlog::warn("SessionRecorder: No SKSE log directory - not recording");
+        return false;
+    }
+
+    auto path = *logsFolder / "VRClimbing.vcr";
+    if (!m_writer.Open(path.string())) {
+        spdlog::warn("SessionRecorder: Could not create {}", path.string());
+        return false;
+    }
+
+    // Kept between recordings so a new one reuses its buffer
+    if (!m_recorder) {
+        m_recorder = std::make_unique<QueryRecorder>();
+    }
+    m_recorder->TakeQueries(m_frame.queries);  // Drop anything left from an earlier recording
+    m_frame.queries.clear();
+    Raycast::SetRecorder(m_recorder.get());
+
+    m_framesWritten = 0;
+    m_droppedQueries = 0;
+    spdlog::info("SessionRecorder: Recording to {}", path.string());
+    return true;
+}
+
+void SessionRecorder::Stop()
+{
+    Raycast::SetRecorder(nullptr);
+
+    if (m_writer.IsOpen()) {
+        spdlog::info("SessionRecorder: Stopped after {} frames ({:.1f} KB, {} queries not recorded)",
+            m_framesWritten, m_writer.GetBytesWritten() / 1024.0, m_droppedQueries);
+        m_writer.Close();
+    }
+    m_inFrame = false;
+}
+
+void SessionRecorder::BeginFrame(const FrameContext& frame)
+{
+    if (Config::options.recordSession != IsRecording()) {
+        if (Config::options.recordSession) {
+            if (!Start()) {
+                Config::options.recordSession = false;  // Don't retry every frame
+            }
+        } else {
+            Stop();
+        }
+    }
+
+    if (!IsRecording()) {
+        return;
+    }
+
+    SessionStream::FrameInput& input = m_frame.input;
+    input = SessionStream::FrameInput{};
+    input.frameNumber = frame.frameNumber;
+    input.deltaTime = frame.deltaTime;
+
+    if (frame.hasHmd) {
+        input.nodes |= SessionStream::kHasHmd;
+        input.hmd = ToTransform(frame.hmd);
+    }
+    if (frame.hasLeftHand) {
+        input.nodes |= SessionStream::kHasLeftHand;
+        input.leftHand = ToTransform(frame.leftHand);
+    }
+    if (frame.hasRightHand) {
+        input.nodes |= SessionStream::kHasRightHand;
+        input.rightHand = ToTransform(frame.rightHand);
+    }
+
+    if (frame.controller && frame.havokWorldScale > 0.0f) {
+        input.controllerVelocity = ToVec3(frame.havokVelocity / frame.havokWorldScale);
+        if (frame.controller->supportBody.get() != nullptr) {
+            input.support |= SessionStream::kHasSupportBody;
+        }
+        if (frame.controller->surfaceInfo.supportedState == RE::hkpSurfaceInfo::SupportedState::kSupported) {
+            input.support |= SessionStream::kSupported;
+        }
+    }
+
+    // Queries from before this frame (physics step, previous frame's tail) belong to this frame
+    m_frame.queries.clear();
+    m_droppedQueries += m_recorder->TakeQueries(m_frame.queries);
+    m_inFrame = true;
+}
+
+void SessionRecorder::RecordGripEdge(bool isLeft, bool pressed)
+{
+    if (!m_inFrame) {
+        return;
+    }
+
+    uint8_t bit = isLeft ? SessionStream::kLeftGrip : SessionStream::kRightGrip;
+    if (pressed) {
+        m_frame.input.gripPressed |= bit;
+    } else {
+        m_frame.input.gripReleased |= bit;
+    }
+}
+
+void SessionRecorder::EndFrame(const FrameContext& frame, float updateMicros)
+{
+    if (!m_inFrame) {
+        return;
+    }
+    m_inFrame = false;
+
+    SessionStream::FrameOutcome& outcome = m_frame.outcome;
+    outcome = SessionStream::FrameOutcome{};
+    outcome.updateMicros = updateMicros;
+    if (frame.player) {
+        outcome.playerPosition = ToVec3(frame.player->GetPosition());  // Live - the update moved the player
+    }
+
+    auto* climbManager = ClimbManager::GetSingleton();
+    if (climbManager->IsHandGrabbing(true)) {
+        outcome.state |= SessionStream::kLeftGrabbing;
+    }
+    if (climbManager->IsHandGrabbing(false)) {
+        outcome.state |= SessionStream::kRightGrabbing;
+    }
+    if (BallisticController::GetSingleton()->IsInFlight()) {
+        outcome.state |= SessionStream::kInFlight;
+    }
+    if (ClimbExitCorrector::GetSingleton()->isCorrecting) {
+        outcome.state |= SessionStream::kCorrecting;
+    }
+
+    m_droppedQueries += m_recorder->TakeQueries(m_frame.queries);
+
+    if (!m_writer.Write(m_frame)) {
+        spdlog::warn("SessionRecorder: Write failed - recording stopped");
+        Config::options.recordSession = false;
+        Stop();
+        return;
+    }
+    m_framesWritten++;
+}
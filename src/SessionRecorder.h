@@ -0,0 +1,48 @@
+#pragma once
+
+#include "RE/Skyrim.h"
+#include "FrameContext.h"
+#include "util/SessionStream.h"
+#include "util/QueryRecorder.h"
+#include <memory>
+
+// Records climbing sessions for offline profiling and regression checks (Config::options.recordSession)
+// Each frame's tracked inputs, outcome and query answers go to <SKSE logs>/VRClimbing.vcr
+// (format in util/SessionStream.h). tools/replay reads the file back headless.
+// Queries are captured at the Raycast API (Raycast::SetRecorder), so cache hits are recorded too.
+class SessionRecorder
+{
+public:
+    static SessionRecorder* GetSingleton();
+
+    // Top of the frame update, right after FrameContext::Begin
+    // Starts or stops recording when the option changed (hot reload), then captures the frame's inputs
+    void BeginFrame(const FrameContext& frame);
+
+    // Grip edge delivered to ClimbManager this frame
+    void RecordGripEdge(bool isLeft, bool pressed);
+
+    // End of the frame update - captures the outcome and writes the frame
+    // updateMicros: time spent in the climbing update this frame
+    void EndFrame(const FrameContext& frame, float updateMicros);
+
+    // Close the file and stop recording queries
+    void Stop();
+
+    bool IsRecording() const { return m_writer.IsOpen(); }
+
+private:
+    SessionRecorder() = default;
+    ~SessionRecorder() = default;
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    bool Start();
+
+    SessionStream::Writer m_writer;
+    std::unique_ptr<QueryRecorder> m_recorder;
+    SessionStream::Frame m_frame;  // Frame being captured (reused so the query list keeps its capacity)
+    bool m_inFrame = false;
+    uint32_t m_framesWritten = 0;
+    size_t m_droppedQueries = 0;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Lock-free single-producer/single-consumer ring buffer
+// One thread pushes and one other thread pops; neither ever blocks or allocates.
+// Head and tail are free-running counters (masked on access), so all Capacity slots are usable.
+template<typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer only - returns false (item dropped) if the queue is full
+    bool TryPush(const T& item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        m_items[tail & (Capacity - 1)] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only - returns false if the queue is empty
+    bool TryPop(T& outItem)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        outItem = m_items[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Separate cache lines so the two threads don't false-share the counters
+    alignas(64) std::atomic<size_t> m_head{ 0 };  // Next slot to pop (written by the consumer)
+    alignas(64) std::atomic<size_t> m_tail{ 0 };  // Next slot to push (written by the producer)
+    T m_items[Capacity]{};
+};
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "util/QueryBackend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// Per-frame climbing movement samples and a streaming launch velocity estimate
+// Fixed-capacity ring buffer, never allocates. Each sample's velocity, direction and speed weight
+// are computed once when it is pushed and stored structure-of-arrays; running totals of deltaTime
+// and of the weighted direction/velocity sums are updated as samples enter and leave the window.
+// That makes the time-window trim O(1) per evicted sample and the unfiltered launch estimate an
+// O(1) read. The direction cone filter is a dot product per held sample (no sqrt/pow/divide).
+// Free of CommonLib types, so tools/replay estimates launches from recorded hand movement the same way.
+class VelocityHistory
+{
+public:
+    // Upper bound for Config::options.maxVelocitySamples
+    static constexpr size_t MAX_SAMPLES = 64;
+
+    // Samples slower than this carry no direction and are ignored by the estimate
+    static constexpr float MIN_SAMPLE_SPEED = 0.001f;
+
+    struct Estimate {
+        PhysicsQuery::Vec3 velocity;  // Weighted average velocity (zero if no usable samples)
+        float totalWeight = 0.0f;     // Sum of weights of the samples that were kept
+        int rejectedSamples = 0;      // Samples dropped by the direction cone
+    };
+
+    // Append a movement sample, then drop the oldest ones until at most maxSamples remain and the
+    // remaining samples span no more than maxTime seconds (the newest sample is always kept)
+    // exponent is the speed weighting exponent; changing it re-weights the held samples
+    void Push(const PhysicsQuery::Vec3& delta, float deltaTime, int maxSamples, float maxTime, float exponent)
+    {
+        if (exponent != m_exponent) {
+            Reweight(exponent);
+        }
+
+        size_t capacity = static_cast<size_t>(std::clamp(maxSamples, 1, static_cast<int>(MAX_SAMPLES)));
+
+        if (m_count == MAX_SAMPLES) {
+            PopFront();
+        }
+        size_t slot = (m_head + m_count) % MAX_SAMPLES;
+        m_count++;
+
+        m_deltaTime[slot] = deltaTime;
+        m_totalTime += deltaTime;
+
+        m_velX[slot] = m_velY[slot] = m_velZ[slot] = 0.0f;
+        m_dirX[slot] = m_dirY[slot] = m_dirZ[slot] = 0.0f;
+        m_speed[slot] = 0.0f;
+        m_weight[slot] = 0.0f;
+        if (deltaTime > 0.0f) {
+            float invDt = 1.0f / deltaTime;
+            float vx = delta.x * invDt;
+            float vy = delta.y * invDt;
+            float vz = delta.z * invDt;
+            float speed = std::sqrt(vx * vx + vy * vy + vz * vz);
+            if (speed >= MIN_SAMPLE_SPEED) {
+                float invSpeed = 1.0f / speed;
+                m_velX[slot] = vx;
+                m_velY[slot] = vy;
+                m_velZ[slot] = vz;
+                m_dirX[slot] = vx * invSpeed;
+                m_dirY[slot] = vy * invSpeed;
+                m_dirZ[slot] = vz * invSpeed;
+                m_speed[slot] = speed;
+                m_weight[slot] = SpeedWeight(speed, m_exponent);
+                AddToSums(slot, 1.0);
+            }
+        }
+
+        while (m_count > capacity) {
+            PopFront();
+        }
+        while (m_count > 1 && m_totalTime > maxTime) {
+            PopFront();
+        }
+    }
+
+    void Clear()
+    {
+        m_head = 0;
+        m_count = 0;
+        ResetSums();
+    }
+
+    bool Empty() const { return m_count == 0; }
+    size_t Size() const { return m_count; }
+
+    // Sum of deltaTime over the samples currently held
+    float GetTotalTime() const { return static_cast<float>(m_totalTime); }
+
+    // Speed-weighted average velocity of the held samples (weight = speed^exponent)
+    // Samples whose direction is more than the cone's angle away from the weighted dominant direction
+    // are left out; cosThreshold <= -1 disables the cone and the result is read straight from the totals
+    Estimate EstimateVelocity(float cosThreshold) const
+    {
+        Estimate estimate;
+        if (m_totalWeight <= 0.0) {
+            return estimate;
+        }
+
+        if (cosThreshold <= -1.0f) {
+            estimate.totalWeight = static_cast<float>(m_totalWeight);
+            estimate.velocity = {
+                static_cast<float>(m_weightedVelX / m_totalWeight),
+                static_cast<float>(m_weightedVelY / m_totalWeight),
+                static_cast<float>(m_weightedVelZ / m_totalWeight)
+            };
+            return estimate;
+        }
+
+        // Dominant direction from the running weighted direction sum
+        float domX = 0.0f, domY = 0.0f, domZ = 0.0f;
+        double dirMag = std::sqrt(m_weightedDirX * m_weightedDirX + m_weightedDirY * m_weightedDirY + m_weightedDirZ * m_weightedDirZ);
+        if (dirMag > 0.001) {
+            domX = static_cast<float>(m_weightedDirX / dirMag);
+            domY = static_cast<float>(m_weightedDirY / dirMag);
+            domZ = static_cast<float>(m_weightedDirZ / dirMag);
+        }
+
+        // Exact cone rejection over the window
+        float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f, sumWeight = 0.0f;
+        for (size_t i = 0; i < m_count; ++i) {
+            size_t slot = (m_head + i) % MAX_SAMPLES;
+            if (m_speed[slot] <= 0.0f) {
+                continue;  // Not a usable sample
+            }
+
+            float dot = m_dirX[slot] * domX + m_dirY[slot] * domY + m_dirZ[slot] * domZ;
+            if (dot < cosThreshold) {
+                estimate.rejectedSamples++;
+                continue;
+            }
+
+            float weight = m_weight[slot];
+            sumX += m_velX[slot] * weight;
+            sumY += m_velY[slot] * weight;
+            sumZ += m_velZ[slot] * weight;
+            sumWeight += weight;
+        }
+
+        if (sumWeight <= 0.0f) {
+            return estimate;
+        }
+
+        estimate.totalWeight = sumWeight;
+        estimate.velocity = { sumX / sumWeight, sumY / sumWeight, sumZ / sumWeight };
+        return estimate;
+    }
+
+    // speed^exponent with the common exponents (linear, quadratic) special-cased
+    static float SpeedWeight(float speed, float exponent)
+    {
+        if (exponent == 1.0f) {
+            return speed;
+        }
+        if (exponent == 2.0f) {
+            return speed * speed;
+        }
+        if (exponent == 0.0f) {
+            return 1.0f;
+        }
+        return std::pow(speed, exponent);
+    }
+
+private:
+    void AddToSums(size_t slot, double sign)
+    {
+        double weight = sign * m_weight[slot];
+        m_weightedDirX += m_dirX[slot] * weight;
+        m_weightedDirY += m_dirY[slot] * weight;
+        m_weightedDirZ += m_dirZ[slot] * weight;
+        m_weightedVelX += m_velX[slot] * weight;
+        m_weightedVelY += m_velY[slot] * weight;
+        m_weightedVelZ += m_velZ[slot] * weight;
+        m_totalWeight += weight;
+    }
+
+    void ResetSums()
+    {
+        m_totalTime = 0.0;
+        m_weightedDirX = m_weightedDirY = m_weightedDirZ = 0.0;
+        m_weightedVelX = m_weightedVelY = m_weightedVelZ = 0.0;
+        m_totalWeight = 0.0;
+    }
+
+    void PopFront()
+    {
+        m_totalTime -= m_deltaTime[m_head];
+        if (m_speed[m_head] > 0.0f) {
+            AddToSums(m_head, -1.0);
+        }
+        m_head = (m_head + 1) % MAX_SAMPLES;
+        m_count--;
+        if (m_count == 0) {
+            ResetSums();  // Drop accumulated rounding error whenever the buffer drains
+        }
+    }
+
+    // Exponent changed (config reload) - recompute the held samples' weights and the weighted totals
+    void Reweight(float exponent)
+    {
+        m_exponent = exponent;
+        double totalTime = m_totalTime;
+        ResetSums();
+        m_totalTime = totalTime;
+
+        for (size_t i = 0; i < m_count; ++i) {
+            size_t slot = (m_head + i) % MAX_SAMPLES;
+            if (m_speed[slot] > 0.0f) {
+                m_weight[slot] = SpeedWeight(m_speed[slot], exponent);
+                AddToSums(slot, 1.0);
+            }
+        }
+    }
+
+    // Per-sample data, structure-of-arrays (speed 0 = sample ignored by the estimate)
+    float m_deltaTime[MAX_SAMPLES]{};
+    float m_velX[MAX_SAMPLES]{};
+    float m_velY[MAX_SAMPLES]{};
+    float m_velZ[MAX_SAMPLES]{};
+    float m_dirX[MAX_SAMPLES]{};
+    float m_dirY[MAX_SAMPLES]{};
+    float m_dirZ[MAX_SAMPLES]{};
+    float m_speed[MAX_SAMPLES]{};
+    float m_weight[MAX_SAMPLES]{};
+
+    size_t m_head = 0;  // Slot of the oldest sample
+    size_t m_count = 0;
+    float m_exponent = 1.0f;
+
+    // Running totals over the held samples - doubles so add/subtract rounding doesn't drift over a long climb
+    double m_totalTime = 0.0;
+    double m_weightedDirX = 0.0, m_weightedDirY = 0.0, m_weightedDirZ = 0.0;
+    double m_weightedVelX = 0.0, m_weightedVelY = 0.0, m_weightedVelZ = 0.0;
+    double m_totalWeight = 0.0;
+};
@@ -0,0 +1,257 @@
+#include "HavokQueryBackend.h"
+#include "RE/Skyrim.h"
+#include <algorithm>
+#include <optional>
+
+using PhysicsQuery::LayerMask;
+using PhysicsQuery::OutputFlags;
+using PhysicsQuery::QueryHit;
+using PhysicsQuery::RayQuery;
+using PhysicsQuery::Vec3;
+
+static RE::NiPoint3 ToNiPoint(const Vec3& v) {
+    return RE::NiPoint3{ v.x, v.y, v.z };
+}
+
+// Result for a ray that hit nothing - distance is the full ray length
+static QueryHit MakeMissHit(const RayQuery& query) {
+    QueryHit hit;
+    hit.distance = query.maxDistance;
+    hit.point = query.origin + query.direction * query.maxDistance;
+    hit.layer = static_cast<uint32_t>(RE::COL_LAYER::kUnidentified);
+    return hit;
+}
+
+// World captured by BeginFrameWorld for the frame update
+static bool s_hasFrameWorld = false;
+static RE::bhkWorld* s_frameWorld = nullptr;
+static float s_frameWorldScale = 0.0f;
+static bool s_inPhysicsStep = false;
+
+// Physics world of the cell the player is in (nullptr if not available)
+static RE::bhkWorld* GetPlayerWorld() {
+    if (s_hasFrameWorld) {
+        return s_frameWorld;
+    }
+
+    auto* player = RE::PlayerCharacter::GetSingleton();
+    if (!player || !player->parentCell) {
+        return nullptr;
+    }
+    return player->parentCell->GetbhkWorld();
+}
+
+static float GetPlayerWorldScale() {
+    return s_hasFrameWorld ? s_frameWorldScale : RE::bhkWorld::GetWorldScale();
+}
+
+// Ray hit collector that keeps the closest hit on a layer accepted by the mask
+// Havok hands every shape hit along the ray to AddRayHit during a single traversal;
+// hits on rejected layers are dropped there instead of re-casting past them, and
+// accepted hits shrink earlyOutHitFraction so farther geometry is pruned early
+class LayerFilteredRayHitCollector : public RE::hkpClosestRayHitCollector {
+public:
+    LayerFilteredRayHitCollector(LayerMask layerMask, bool wantNormal) :
+        m_layerMask(layerMask),
+        m_wantNormal(wantNormal)
+    {
+        earlyOutHitFraction = 1.0f;
+    }
+
+    void AddRayHit(const RE::hkpCdBody& a_body, const RE::hkpShapeRayCastCollectorOutput& a_hitInfo) override {
+        // Walk up to the root collidable - that's where the collision layer lives
+        const RE::hkpCdBody* root = &a_body;
+        while (root->parent) {
+            root = root->parent;
+        }
+        const auto* collidable = static_cast<const RE::hkpCollidable*>(root);
+
+        RE::COL_LAYER layer = collidable->GetCollisionLayer();
+        LayerMask layerBit = 1ULL << static_cast<uint64_t>(layer);
+        if ((m_layerMask & layerBit) == 0) {
+            return;  // Not a layer we care about - keep looking past it
+        }
+
+        if (a_hitInfo.hitFraction >= earlyOutHitFraction) {
+            return;  // Already have a closer matching hit
+        }
+
+        earlyOutHitFraction = a_hitInfo.hitFraction;
+        m_hitCollidable = collidable;
+        m_hitLayer = layer;
+
+        if (!m_wantNormal) {
+            return;
+        }
+
+        // Havok has already rotated the normal into world space - same as the closest-hit output
+        const auto& n = a_hitInfo.normal.quad.m128_f32;
+        m_hitNormal = { n[0], n[1], n[2] };
+    }
+
+    bool HasHit() const { return m_hitCollidable != nullptr; }
+    float GetHitFraction() const { return earlyOutHitFraction; }
+    const RE::hkpCollidable* GetHitCollidable() const { return m_hitCollidable; }
+    RE::COL_LAYER GetHitLayer() const { return m_hitLayer; }
+    const Vec3& GetHitNormal() const { return m_hitNormal; }
+
+private:
+    LayerMask m_layerMask;
+    bool m_wantNormal;
+    const RE::hkpCollidable* m_hitCollidable = nullptr;
+    RE::COL_LAYER m_hitLayer = RE::COL_LAYER::kUnidentified;
+    Vec3 m_hitNormal;
+};
+
+// Single closest-hit pick against an already resolved world
+static QueryHit CastClosestInWorld(RE::bhkWorld* physicsWorld, float havokWorldScale, const RayQuery& query) {
+    QueryHit result = MakeMissHit(query);
+
+    RE::NiPoint3 rayStart = ToNiPoint(query.origin);
+    RE::NiPoint3 rayEnd = ToNiPoint(result.point);
+
+    RE::bhkPickData pickData;
+    pickData.rayInput.from = rayStart * havokWorldScale;
+    pickData.rayInput.to = rayEnd * havokWorldScale;
+
+    // Use default collector (bhkPickData has built-in ray output)
+    physicsWorld->PickObject(pickData);
+
+    // Check if we got a hit using the default ray hit output
+    if (pickData.rayOutput.HasHit()) {
+        float hitFraction = pickData.rayOutput.hitFraction;
+        result.hit = true;
+        result.distance = query.maxDistance * hitFraction;
+        result.point = query.origin + query.direction * result.distance;
+        result.normal = {
+            pickData.rayOutput.normal.quad.m128_f32[0],
+            pickData.rayOutput.normal.quad.m128_f32[1],
+            pickData.rayOutput.normal.quad.m128_f32[2]
+        };
+
+        // Extract collision layer and hit reference from collidable
+        if (pickData.rayOutput.rootCollidable) {
+            result.layer = static_cast<uint32_t>(pickData.rayOutput.rootCollidable->GetCollisionLayer());
+            // Try to get the TESObjectREFR from the collidable - skipped unless asked for
+            if (query.outputs & PhysicsQuery::kOutputUserData) {
+                result.userData = RE::TESHavokUtilities::FindCollidableRef(*pickData.rayOutput.rootCollidable);
+            }
+        }
+    }
+
+    return result;
+}
+
+// Layer-filtered pick against an already resolved world - one Havok traversal per query
+static QueryHit CastRayInWorld(RE::bhkWorld* physicsWorld, float havokWorldScale, const RayQuery& query) {
+    // Accepting every layer is just a closest-hit query
+    if (query.layerMask == PhysicsQuery::kAllLayers) {
+        return CastClosestInWorld(physicsWorld, havokWorldScale, query);
+    }
+
+    QueryHit result = MakeMissHit(query);
+
+    LayerFilteredRayHitCollector collector(query.layerMask, (query.outputs & PhysicsQuery::kOutputNormal) != 0);
+
+    RE::bhkPickData pickData;
+    pickData.rayInput.from = ToNiPoint(query.origin) * havokWorldScale;
+    pickData.rayInput.to = ToNiPoint(result.point) * havokWorldScale;
+    pickData.rayHitCollectorA8 = &collector;
+
+    physicsWorld->PickObject(pickData);
+
+    if (!collector.HasHit()) {
+        return result;
+    }
+
+    result.hit = true;
+    result.distance = query.maxDistance * collector.GetHitFraction();
+    result.point = query.origin + query.direction * result.distance;
+    result.normal = collector.GetHitNormal();
+    result.layer = static_cast<uint32_t>(collector.GetHitLayer());
+    // Only the winning hit pays for the collidable -> reference lookup, and only if asked for
+    if (query.outputs & PhysicsQuery::kOutputUserData) {
+        result.userData = RE::TESHavokUtilities::FindCollidableRef(*collector.GetHitCollidable());
+    }
+
+    return result;
+}
+
+HavokQueryBackend* HavokQueryBackend::GetSingleton()
+{
+    static HavokQueryBackend instance;
+    return &instance;
+}
+
+void HavokQueryBackend::BeginFrameWorld(RE::bhkWorld* physicsWorld, float havokWorldScale)
+{
+    s_hasFrameWorld = true;
+    s_frameWorld = physicsWorld;
+    s_frameWorldScale = havokWorldScale;
+}
+
+void HavokQueryBackend::EndFrameWorld()
+{
+    s_hasFrameWorld = false;
+    s_frameWorld = nullptr;
+}
+
+void HavokQueryBackend::SetInPhysicsStep(bool inPhysicsStep)
+{
+    s_inPhysicsStep = inPhysicsStep;
+}
+
+QueryHit HavokQueryBackend::CastRay(const RayQuery& query)
+{
+    auto* physicsWorld = GetPlayerWorld();
+    if (!physicsWorld) {
+        return MakeMissHit(query);
+    }
+
+    return CastRayInWorld(physicsWorld, GetPlayerWorldScale(), query);
+}
+
+void HavokQueryBackend::CastRays(std::span<const RayQuery> queries, std::span<QueryHit> hits)
+{
+    const size_t count = (std::min)(queries.size(), hits.size());
+    if (count == 0) {
+        return;
+    }
+
+    auto* physicsWorld = GetPlayerWorld();
+    if (!physicsWorld) {
+        for (size_t i = 0; i < count; ++i) {
+            hits[i] = MakeMissHit(queries[i]);
+        }
+        return;
+    }
+
+    float havokWorldScale = GetPlayerWorldScale();
+
+    // Hold the world read lock across the whole batch instead of per pick
+    std::optional<RE::BSReadLockGuard> locker;
+    if (!s_inPhysicsStep) {
+        locker.emplace(physicsWorld->worldLock);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        hits[i] = CastRayInWorld(physicsWorld, havokWorldScale, queries[i]);
+    }
+}
+
+QueryHit HavokQueryBackend::CastMultiDirectionalRays(const Vec3& origin, float maxDistance, LayerMask layerMask, OutputFlags outputs)
+{
+    auto* physicsWorld = GetPlayerWorld();
+    if (!physicsWorld) {
+        QueryHit miss;
+        miss.distance = maxDistance;
+        miss.point = origin;
+        return miss;
+    }
+
+    std::optional<RE::BSReadLockGuard> locker;
+    if (!s_inPhysicsStep) {
+        locker.emplace(physicsWorld->worldLock);
+    }
+    return QueryBackend::CastMultiDirectionalRays(origin, maxDistance, layerMask, outputs);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "QueryBackend.h"
+
+// Query backend for the running game - picks against the bhkWorld of the player's cell
+// Hits report the COL_LAYER of the root collidable and the TESObjectREFR* that owns it as userData
+// userData is only looked up when the query asks for kOutputUserData
+class HavokQueryBackend : public PhysicsQuery::QueryBackend
+{
+public:
+    static HavokQueryBackend* GetSingleton();
+
+    PhysicsQuery::QueryHit CastRay(const PhysicsQuery::RayQuery& query) override;
+
+    // Takes the world lookup and world read lock once for the whole batch (no lock inside the physics step)
+    void CastRays(std::span<const PhysicsQuery::RayQuery> queries, std::span<PhysicsQuery::QueryHit> hits) override;
+
+    // The default 6 cardinal rays (see QueryBackend), with the world looked up and read-locked once for all
+    // 6 picks rather than per pick
+    PhysicsQuery::QueryHit CastMultiDirectionalRays(const PhysicsQuery::Vec3& origin, float maxDistance,
+        PhysicsQuery::LayerMask layerMask, PhysicsQuery::OutputFlags outputs) override;
+
+    // Use this world and scale for queries until EndFrameWorld
+    // Set by FrameContext for the frame update; queries outside it (the physics pre-step, input
+    // handlers) still look the player's world up per call
+    void BeginFrameWorld(RE::bhkWorld* physicsWorld, float havokWorldScale);
+    void EndFrameWorld();
+
+    // Set around the physics pre-step - bhkWorld::Update may hold the world lock for the step it is about
+    // to run, so queries from there don't take the read lock again
+    void SetInPhysicsStep(bool inPhysicsStep);
+
+private:
+    HavokQueryBackend() = default;
+    HavokQueryBackend(const HavokQueryBackend&) = delete;
+    HavokQueryBackend& operator=(const HavokQueryBackend&) = delete;
+};
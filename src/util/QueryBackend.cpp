@@ -0,0 +1,92 @@
+#include "QueryBackend.h"
+#include <algorithm>
+
+namespace PhysicsQuery {
+
+// Directions of CastMultiDirectionalRays: the 6 cardinal directions the grab probe always used
+static constexpr Vec3 MULTI_DIRECTIONAL_RAYS[] = {
+    { 1.0f,  0.0f,  0.0f}, {-1.0f,  0.0f,  0.0f},
+    { 0.0f,  1.0f,  0.0f}, { 0.0f, -1.0f,  0.0f},
+    { 0.0f,  0.0f,  1.0f}, { 0.0f,  0.0f, -1.0f},
+};
+
+// Rays of the default SweepCapsule: one from the center of each end cap (head and bottom of the body)
+static constexpr size_t SWEEP_RAYS = 2;
+
+// Sample rays for the default capsule sweep - each starts at its cap's center and reaches the radius further,
+// so a cap already touching a wall still reports it; the radius is the lead taken off the hit distance
+static void BuildSweepRays(const CapsuleSweep& sweep, RayQuery* queries) {
+    const Vec3 centers[SWEEP_RAYS] = { sweep.segmentEnd, sweep.segmentStart };
+    for (size_t i = 0; i < SWEEP_RAYS; ++i) {
+        queries[i] = RayQuery{ centers[i], sweep.direction, sweep.maxDistance + sweep.radius, sweep.layerMask,
+            sweep.outputs };
+    }
+}
+
+// Nothing hit yet - the capsule travels the whole way
+static QueryHit MakeClearSweep(const CapsuleSweep& sweep) {
+    QueryHit first;
+    first.distance = sweep.maxDistance;
+    first.point = sweep.segmentStart + sweep.direction * sweep.maxDistance;
+    return first;
+}
+
+// Earliest contact among a sweep's sample ray hits
+static QueryHit ReduceSweepHits(const CapsuleSweep& sweep, const QueryHit* hits) {
+    QueryHit first = MakeClearSweep(sweep);
+    for (size_t i = 0; i < SWEEP_RAYS; ++i) {
+        if (!hits[i].hit) {
+            continue;
+        }
+        float travel = (std::max)(hits[i].distance - sweep.radius, 0.0f);
+        if (!first.hit || travel < first.distance) {
+            first = hits[i];
+            first.distance = travel;
+        }
+    }
+    return first;
+}
+
+void QueryBackend::CastRays(std::span<const RayQuery> queries, std::span<QueryHit> hits) {
+    const size_t count = (std::min)(queries.size(), hits.size());
+    for (size_t i = 0; i < count; ++i) {
+        hits[i] = CastRay(queries[i]);
+    }
+}
+
+QueryHit QueryBackend::CastMultiDirectionalRays(const Vec3& origin, float maxDistance, LayerMask layerMask, OutputFlags outputs) {
+    QueryHit nearest;
+    nearest.distance = maxDistance;
+    nearest.point = origin;
+
+    if (maxDistance <= 0.0f) {
+        return nearest;
+    }
+
+    for (const auto& direction : MULTI_DIRECTIONAL_RAYS) {
+        // Nothing farther than the current nearest contact can win - shorten the ray so it prunes early
+        RayQuery query{ origin, direction, nearest.hit ? nearest.distance : maxDistance, layerMask, outputs };
+        QueryHit hit = CastRay(query);
+        if (hit.hit && (!nearest.hit || hit.distance < nearest.distance)) {
+            nearest = hit;
+        }
+    }
+
+    return nearest;
+}
+
+QueryHit QueryBackend::SweepCapsule(const CapsuleSweep& sweep) {
+    if (sweep.maxDistance <= 0.0f) {
+        return MakeClearSweep(sweep);
+    }
+
+    RayQuery queries[SWEEP_RAYS];
+    BuildSweepRays(sweep, queries);
+
+    QueryHit hits[SWEEP_RAYS];
+    CastRays(std::span<const RayQuery>(queries, SWEEP_RAYS), std::span<QueryHit>(hits, SWEEP_RAYS));
+
+    return ReduceSweepHits(sweep, hits);
+}
+
+} // namespace PhysicsQuery
@@ -0,0 +1,102 @@
+#pragma once
+
+// Physics query backend interface
+// Raycast forwards every physics query to the active backend (see Raycast::SetBackend).
+// This header is free of CommonLib/Windows types, so queries can be answered off the game against a
+// stand-in world (see tools/replay/MeshQueryBackend.h).
+
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+namespace PhysicsQuery {
+
+struct Vec3 {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+
+    Vec3 operator+(const Vec3& o) const { return { x + o.x, y + o.y, z + o.z }; }
+    Vec3 operator-(const Vec3& o) const { return { x - o.x, y - o.y, z - o.z }; }
+    Vec3 operator*(float s) const { return { x * s, y * s, z * s }; }
+};
+
+inline float Dot(const Vec3& a, const Vec3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Vec3 Cross(const Vec3& a, const Vec3& b) {
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+inline float Length(const Vec3& v) {
+    return std::sqrt(Dot(v, v));
+}
+
+// Bit per collision layer, same layout as CollisionLayerMask in Raycast.h
+using LayerMask = uint64_t;
+constexpr LayerMask kAllLayers = ~0ULL;
+
+// Hit fields a query needs beyond hit/distance/point
+// Backends skip the work for fields that aren't requested (Havok: the collidable -> reference walk
+// for userData) and leave them at their defaults; cheap fields may still be filled
+using OutputFlags = uint8_t;
+constexpr OutputFlags kOutputNormal = 1 << 0;
+constexpr OutputFlags kOutputLayer = 1 << 1;
+constexpr OutputFlags kOutputUserData = 1 << 2;
+constexpr OutputFlags kAllOutputs = kOutputNormal | kOutputLayer | kOutputUserData;
+
+struct RayQuery {
+    Vec3 origin;
+    Vec3 direction;                    // Must be normalized
+    float maxDistance = 0.0f;          // Game units
+    LayerMask layerMask = kAllLayers;  // kAllLayers = plain closest-hit ray
+    OutputFlags outputs = kAllOutputs;
+};
+
+// Capsule moved in a straight line (character-sized body sweeps)
+struct CapsuleSweep {
+    Vec3 segmentStart;                 // Capsule axis endpoints at the start of the sweep
+    Vec3 segmentEnd;
+    float radius = 0.0f;
+    Vec3 direction;                    // Must be normalized
+    float maxDistance = 0.0f;          // How far the capsule travels
+    LayerMask layerMask = kAllLayers;
+    OutputFlags outputs = kAllOutputs;
+};
+
+struct QueryHit {
+    bool hit = false;
+    float distance = 0.0f;     // Along the ray, or travelled by a swept capsule
+    Vec3 point;
+    Vec3 normal;               // World space
+    uint32_t layer = 0;        // Collision layer of the hit (only valid if hit == true)
+    void* userData = nullptr;  // Backend-specific hit object (Havok: TESObjectREFR*, mesh: AddMesh userData)
+};
+
+class QueryBackend {
+public:
+    virtual ~QueryBackend() = default;
+
+    // Closest hit along the ray on a layer accepted by the query's mask
+    virtual QueryHit CastRay(const RayQuery& query) = 0;
+
+    // Resolve several rays - hits[i] is filled for queries[i]
+    // Default loops over CastRay; backends override to share setup (locks, world lookup) across the batch
+    virtual void CastRays(std::span<const RayQuery> queries, std::span<QueryHit> hits);
+
+    // Nearest hit of 6 rays from origin along the cardinal directions, each maxDistance long and clipped to the
+    // nearest contact so far - the grab probe's picks, unchanged. Not a sphere query: surfaces between the
+    // axes are missed. Backends override it only to share setup across the 6 picks
+    virtual QueryHit CastMultiDirectionalRays(const Vec3& origin, float maxDistance, LayerMask layerMask, OutputFlags outputs);
+
+    // First contact of a capsule swept along a direction, on layers accepted by the mask
+    // distance is how far the capsule gets before touching (time of impact * maxDistance); point and
+    // normal are the contact. Geometry already inside the capsule's leading half stops it at distance 0.
+    // Default casts one ray along the sweep from each end cap's center, as one CastRays batch - the same
+    // two picks as the old head and floor rays, so geometry that fits between the caps (a thin ledge at
+    // chest height) is still missed. Backends with a real shape cast override it
+    virtual QueryHit SweepCapsule(const CapsuleSweep& sweep);
+};
+
+} // namespace PhysicsQuery
@@ -0,0 +1,20 @@
+#include "QueryRecorder.h"
+
+void QueryRecorder::Record(const SessionStream::QueryRecord& record)
+{
+    if (m_pending.size() >= MAX_PENDING_QUERIES) {
+        m_dropped++;
+        return;
+    }
+    m_pending.push_back(record);
+}
+
+size_t QueryRecorder::TakeQueries(std::vector<SessionStream::QueryRecord>& outQueries)
+{
+    outQueries.insert(outQueries.end(), m_pending.begin(), m_pending.end());
+    m_pending.clear();
+
+    size_t dropped = m_dropped;
+    m_dropped = 0;
+    return dropped;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "SessionStream.h"
+#include <vector>
+
+// Keeps a copy of every query answer Raycast hands back to the climbing code while a session is recorded
+// Set with Raycast::SetRecorder (see SessionRecorder); the recorder collects the queries once per frame.
+// Recording happens at the Raycast API, after the per-frame cache, so answers served from the cache are
+// recorded like any other - the stream holds exactly what the climbing code read.
+// Main thread only - the physics pre-step that issues deferred and physics-step queries runs there too.
+class QueryRecorder
+{
+public:
+    // Queries held between collections - beyond this they are still answered but not recorded
+    static constexpr size_t MAX_PENDING_QUERIES = 4096;
+
+    void Record(const SessionStream::QueryRecord& record);
+
+    // Move the queries recorded since the last call to the end of outQueries
+    // Returns how many were dropped because MAX_PENDING_QUERIES was reached
+    size_t TakeQueries(std::vector<SessionStream::QueryRecord>& outQueries);
+
+private:
+    std::vector<SessionStream::QueryRecord> m_pending;
+    size_t m_dropped = 0;
+};
@@ -0,0 +1,111 @@
+#include "QueryScheduler.h"
+#include "../Config.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+
+namespace QueryScheduler {
+
+// A task deferred this many frames runs even if the budget is spent
+static constexpr uint32_t MAX_DEFER_FRAMES = 10;
+
+// Weight of the newest sample in each task's running cost estimate
+static constexpr float COST_ESTIMATE_WEIGHT = 0.25f;
+
+struct TaskSlot {
+    TaskFunc func = nullptr;
+    Priority priority = Priority::kLow;
+    uint32_t requestFrame = 0;     // Frame the task was first requested (for aging)
+    float estimatedMicros = 0.0f;  // Running average of measured cost (0 until first run)
+    bool pending = false;
+};
+
+static TaskSlot s_tasks[static_cast<size_t>(Task::kCount)];
+static uint32_t s_frame = 0;
+
+static TaskSlot& GetSlot(Task task) {
+    return s_tasks[static_cast<size_t>(task)];
+}
+
+void Request(Task task, Priority priority, TaskFunc func) {
+    TaskSlot& slot = GetSlot(task);
+    slot.func = func;
+
+    if (!slot.pending) {
+        slot.pending = true;
+        slot.priority = priority;
+        slot.requestFrame = s_frame;
+    } else if (priority < slot.priority) {
+        slot.priority = priority;
+    }
+}
+
+void Cancel(Task task) {
+    GetSlot(task).pending = false;
+}
+
+bool IsPending(Task task) {
+    return GetSlot(task).pending;
+}
+
+void RunFrame() {
+    using Clock = std::chrono::steady_clock;
+
+    // Run order: priority, then oldest request first
+    size_t order[static_cast<size_t>(Task::kCount)];
+    size_t pendingCount = 0;
+    for (size_t i = 0; i < static_cast<size_t>(Task::kCount); ++i) {
+        if (s_tasks[i].pending) {
+            order[pendingCount++] = i;
+        }
+    }
+
+    // Nothing requested - the common case outside climbing and flight
+    if (pendingCount == 0) {
+        ++s_frame;
+        return;
+    }
+
+    std::sort(order, order + pendingCount, [](size_t a, size_t b) {
+        const TaskSlot& lhs = s_tasks[a];
+        const TaskSlot& rhs = s_tasks[b];
+        if (lhs.priority != rhs.priority) {
+            return lhs.priority < rhs.priority;
+        }
+        return lhs.requestFrame < rhs.requestFrame;
+    });
+
+    // 0 = no budget, run everything that's pending
+    const float budget = static_cast<float>((std::max)(Config::options.queryBudgetMicros, 0));
+    float spent = 0.0f;
+    bool ranAny = false;
+
+    for (size_t n = 0; n < pendingCount; ++n) {
+        TaskSlot& slot = s_tasks[order[n]];
+
+        bool overdue = s_frame - slot.requestFrame >= MAX_DEFER_FRAMES;
+        bool fits = budget <= 0.0f || spent + slot.estimatedMicros <= budget;
+        if (ranAny && !fits && !overdue) {
+            spdlog::trace("QueryScheduler: Deferring task {} (estimate {:.0f}us, {:.0f}/{:.0f}us spent)",
+                order[n], slot.estimatedMicros, spent, budget);
+            continue;
+        }
+
+        // Clear before running so the task may re-request itself
+        slot.pending = false;
+
+        auto start = Clock::now();
+        slot.func();
+        float micros = std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+
+        slot.estimatedMicros = slot.estimatedMicros > 0.0f
+            ? slot.estimatedMicros + (micros - slot.estimatedMicros) * COST_ESTIMATE_WEIGHT
+            : micros;
+        spent += micros;
+        ranAny = true;
+    }
+
+    ++s_frame;
+}
+
+} // namespace QueryScheduler
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+// Spreads non-urgent physics queries over frames under a per-frame time budget
+// (Config::options.queryBudgetMicros), so periodic checks never pile up on the same frame.
+// Urgent queries (grab on grip press, wall clamp) don't go through here - they call Raycast directly.
+// Main thread only.
+namespace QueryScheduler {
+
+// Deferrable query tasks - one pending slot each, so repeated requests coalesce instead of queueing
+enum class Task : uint8_t {
+    kSafePositionCheck,    // ClimbExitCorrector ground/ceiling check
+    kCriticalStrikeCheck,  // CriticalStrikeManager impact ray
+    kPostFlightAutoCatch,  // Auto-catch probes during the post-flight window
+    kGrabReadiness,        // Re-checks of ClimbManager's cached grab readiness (GrabReadinessTracker)
+    kCount
+};
+
+// Higher priorities run first; within a priority, the longest-waiting task runs first
+enum class Priority : uint8_t {
+    kHigh,
+    kNormal,
+    kLow
+};
+
+using TaskFunc = void(*)();
+
+// Queue a task to run on this or a later frame
+// If the task is already pending, its function is replaced and it keeps its place in line
+// (priority is raised if the new request is more important)
+void Request(Task task, Priority priority, TaskFunc func);
+
+// Drop a pending task without running it
+void Cancel(Task task);
+
+bool IsPending(Task task);
+
+// Run pending tasks until the frame budget is spent. Call once per frame on the main thread,
+// after the managers have made their requests.
+// At least one task runs every frame, and tasks deferred for too long run regardless of budget,
+// so low priority work is delayed but never starved.
+void RunFrame();
+
+} // namespace QueryScheduler
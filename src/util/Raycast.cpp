@@ -1,149 +1,683 @@
 #include "Raycast.h"
+#include "HavokQueryBackend.h"
+#include "QueryRecorder.h"
+#include "../Config.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
 #include <cmath>
+#include <unordered_map>
+
+#ifdef VRCLIMBING_RAYCAST_STATS
+#include <chrono>
+#include <iterator>
+#include <string>
+#include <utility>
+#endif
 
 namespace Raycast {
 
-RaycastResult CastRay(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance) {
+// ===== Per-frame query cache state =====
+
+// Quantization steps for cache keys - queries closer than this are treated as identical
+static constexpr float CACHE_POSITION_STEP = 0.1f;     // Game units (origin and ray length)
+static constexpr float CACHE_DIRECTION_STEP = 0.001f;  // Unit-vector components
+
+// Log hit/miss totals every N frames (debug level)
+static constexpr uint32_t CACHE_LOG_INTERVAL_FRAMES = 900;
+
+struct QueryKey {
+    int32_t ox, oy, oz;
+    int32_t dx, dy, dz;
+    int32_t length;
+    CollisionLayerMask layerMask;
+
+    bool operator==(const QueryKey&) const = default;
+};
+
+struct QueryKeyHash {
+    size_t operator()(const QueryKey& key) const noexcept {
+        // FNV-1a style combine over the quantized fields
+        uint64_t h = 1469598103934665603ULL;
+        auto mix = [&h](uint64_t v) {
+            h ^= v;
+            h *= 1099511628211ULL;
+        };
+        mix(static_cast<uint32_t>(key.ox));
+        mix(static_cast<uint32_t>(key.oy));
+        mix(static_cast<uint32_t>(key.oz));
+        mix(static_cast<uint32_t>(key.dx));
+        mix(static_cast<uint32_t>(key.dy));
+        mix(static_cast<uint32_t>(key.dz));
+        mix(static_cast<uint32_t>(key.length));
+        mix(key.layerMask);
+        return static_cast<size_t>(h);
+    }
+};
+
+// Result plus the output flags it was resolved with - a lean result can't answer a query wanting more
+struct CachedQuery {
     RaycastResult result;
-    result.hit = false;
-    result.distance = maxDistance;
-    result.hitPoint = origin + direction * maxDistance;
-    result.hitNormal = {0.0f, 0.0f, 0.0f};
-    result.collisionLayer = RE::COL_LAYER::kUnidentified;
-    result.hitRef = nullptr;
+    RaycastOutputFlags outputs;
+};
+
+static std::unordered_map<QueryKey, CachedQuery, QueryKeyHash> s_frameCache;
+static bool s_inFrame = false;  // Between BeginFrame and EndFrame
+static CacheStats s_cacheStats;
+static CacheStats s_cacheStatsAtLastLog;
+static uint32_t s_frameEpoch = 0;
+
+static int32_t Quantize(float value, float step) {
+    return static_cast<int32_t>(std::lround(value / step));
+}
+
+static QueryKey MakeQueryKey(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance, CollisionLayerMask layerMask) {
+    return QueryKey{
+        Quantize(origin.x, CACHE_POSITION_STEP),
+        Quantize(origin.y, CACHE_POSITION_STEP),
+        Quantize(origin.z, CACHE_POSITION_STEP),
+        Quantize(direction.x, CACHE_DIRECTION_STEP),
+        Quantize(direction.y, CACHE_DIRECTION_STEP),
+        Quantize(direction.z, CACHE_DIRECTION_STEP),
+        Quantize(maxDistance, CACHE_POSITION_STEP),
+        layerMask
+    };
+}
+
+// Only the frame update uses the cache - the physics pre-step runs between frames, after the world has moved
+static bool IsCacheUsable() {
+    return Config::options.raycastCacheEnabled && s_inFrame;
+}
+
+// Looks up a cached result carrying every requested output, counting the hit or miss
+// On a miss, outputs is widened by whatever a stale entry already had, so re-resolving
+// it doesn't lose fields an earlier query asked for
+static bool FindCachedQuery(const QueryKey& key, RaycastOutputFlags& outputs, RaycastResult& outResult) {
+    if (auto it = s_frameCache.find(key); it != s_frameCache.end()) {
+        if ((it->second.outputs & outputs) == outputs) {
+            ++s_cacheStats.hits;
+            outResult = it->second.result;
+            return true;
+        }
+        outputs |= it->second.outputs;
+    }
+    ++s_cacheStats.misses;
+    return false;
+}
+
+#ifdef VRCLIMBING_RAYCAST_STATS
+// ===== Query instrumentation state =====
+
+// Rolling summary is logged this often (window stats reset after each summary)
+static constexpr float STATS_LOG_INTERVAL_SECONDS = 10.0f;
+
+// Latency histogram bucket upper bounds in microseconds - the last bucket is open-ended
+static constexpr uint32_t LATENCY_BUCKET_LIMITS_US[] = { 5, 10, 25, 50, 100, 250, 500, 1000 };
+static constexpr size_t LATENCY_BUCKET_COUNT = std::size(LATENCY_BUCKET_LIMITS_US) + 1;
+
+static constexpr const char* QUERY_SITE_NAMES[] = {
+    "untagged",
+    "surface-detector-rays",
+    "surface-detector-hmd",
+    "surface-detector-directional",
+    "auto-catch",
+    "climb-sweep",
+    "ghost-path",
+    "ghost-floor",
+    "landing-penetration",
+    "landing-prediction",
+    "exit-detect",
+    "exit-escape",
+    "exit-safe-position",
+    "critical-impact",
+    "deferred-batch",
+};
+static_assert(std::size(QUERY_SITE_NAMES) == static_cast<size_t>(QuerySite::kCount));
+
+struct SiteStats {
+    uint64_t picks = 0;
+    uint64_t hits = 0;
+    uint64_t totalMicros = 0;
+    uint64_t buckets[LATENCY_BUCKET_COUNT] = {};
+};
+
+struct FrameWindowStats {
+    uint64_t frames = 0;
+    uint64_t picks = 0;
+    uint64_t micros = 0;
+    uint64_t maxPicks = 0;
+    uint64_t maxMicros = 0;
+};
+
+static SiteStats s_siteStats[static_cast<size_t>(QuerySite::kCount)];
+static QuerySite s_currentSite = QuerySite::kUntagged;
+
+// Totals for the frame in progress - folded into s_frameWindow by BeginFrame
+static uint64_t s_framePicks = 0;
+static uint64_t s_frameMicros = 0;
+static FrameWindowStats s_frameWindow;
+static std::chrono::steady_clock::time_point s_lastStatsLog;
+static bool s_hasLastStatsLog = false;
+
+QuerySite SetQuerySite(QuerySite site) {
+    QuerySite previous = s_currentSite;
+    s_currentSite = site;
+    return previous;
+}
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player || !player->parentCell) {
-        return result;
+static void RecordPick(uint64_t micros, bool hit) {
+    SiteStats& stats = s_siteStats[static_cast<size_t>(s_currentSite)];
+
+    size_t bucket = 0;
+    while (bucket < std::size(LATENCY_BUCKET_LIMITS_US) && micros > LATENCY_BUCKET_LIMITS_US[bucket]) {
+        ++bucket;
     }
 
-    auto* physicsWorld = player->parentCell->GetbhkWorld();
-    if (!physicsWorld) {
-        return result;
+    stats.picks++;
+    if (hit) {
+        stats.hits++;
     }
+    stats.totalMicros += micros;
+    stats.buckets[bucket]++;
 
-    float havokWorldScale = RE::bhkWorld::GetWorldScale();
+    s_framePicks++;
+    s_frameMicros += micros;
+}
 
-    RE::NiPoint3 rayStart = origin;
-    RE::NiPoint3 rayEnd = origin + direction * maxDistance;
+// Times one backend query (or batch) and attributes it to the current call site
+class PickTimer {
+public:
+    PickTimer() : m_start(std::chrono::steady_clock::now()) {}
 
-    RE::bhkPickData pickData;
-    pickData.rayInput.from = rayStart * havokWorldScale;
-    pickData.rayInput.to = rayEnd * havokWorldScale;
+    void Stop(bool hit) const {
+        RecordPick(ElapsedMicros(), hit);
+    }
 
-    // Use default collector (bhkPickData has built-in ray output)
-    physicsWorld->PickObject(pickData);
+    // Batches are timed as a whole, so each ray is charged an equal share
+    void StopBatch(std::span<const PhysicsQuery::QueryHit> hits) const {
+        uint64_t share = ElapsedMicros() / (std::max)(hits.size(), static_cast<size_t>(1));
+        for (const auto& hit : hits) {
+            RecordPick(share, hit.hit);
+        }
+    }
 
-    // Check if we got a hit using the default ray hit output
-    if (pickData.rayOutput.HasHit()) {
-        float hitFraction = pickData.rayOutput.hitFraction;
-        result.hit = true;
-        result.distance = maxDistance * hitFraction;
-        result.hitPoint = origin + direction * result.distance;
-        result.hitNormal = {
-            pickData.rayOutput.normal.quad.m128_f32[0],
-            pickData.rayOutput.normal.quad.m128_f32[1],
-            pickData.rayOutput.normal.quad.m128_f32[2]
-        };
+private:
+    uint64_t ElapsedMicros() const {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
 
-        // Extract collision layer and hit reference from collidable
-        if (pickData.rayOutput.rootCollidable) {
-            result.collisionLayer = pickData.rayOutput.rootCollidable->GetCollisionLayer();
-            // Try to get the TESObjectREFR from the collidable
-            result.hitRef = RE::TESHavokUtilities::FindCollidableRef(*pickData.rayOutput.rootCollidable);
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Upper bound of the histogram bucket containing the given percentile (0-1)
+static std::string DescribePercentile(const uint64_t (&buckets)[LATENCY_BUCKET_COUNT], uint64_t total, double percentile) {
+    uint64_t target = static_cast<uint64_t>(std::ceil(static_cast<double>(total) * percentile));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < LATENCY_BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            if (i < std::size(LATENCY_BUCKET_LIMITS_US)) {
+                return "<=" + std::to_string(LATENCY_BUCKET_LIMITS_US[i]) + "us";
+            }
+            break;
         }
     }
+    return ">" + std::to_string(LATENCY_BUCKET_LIMITS_US[std::size(LATENCY_BUCKET_LIMITS_US) - 1]) + "us";
+}
 
-    return result;
+// Fold the finished frame into the window and log a summary once the interval has elapsed
+static void UpdateQueryStats() {
+    uint64_t framePicks = std::exchange(s_framePicks, 0);
+    uint64_t frameMicros = std::exchange(s_frameMicros, 0);
+
+    s_frameWindow.frames++;
+    s_frameWindow.picks += framePicks;
+    s_frameWindow.micros += frameMicros;
+    s_frameWindow.maxPicks = (std::max)(s_frameWindow.maxPicks, framePicks);
+    s_frameWindow.maxMicros = (std::max)(s_frameWindow.maxMicros, frameMicros);
+
+    auto now = std::chrono::steady_clock::now();
+    if (!s_hasLastStatsLog) {
+        s_lastStatsLog = now;
+        s_hasLastStatsLog = true;
+        return;
+    }
+
+    float elapsed = std::chrono::duration<float>(now - s_lastStatsLog).count();
+    if (elapsed < STATS_LOG_INTERVAL_SECONDS) {
+        return;
+    }
+
+    double frames = static_cast<double>(s_frameWindow.frames);
+    spdlog::info("Raycast stats: {:.1f}s, {} frames, {:.1f} picks/frame (max {}), {:.1f}us/frame (max {}us)",
+        elapsed, s_frameWindow.frames,
+        static_cast<double>(s_frameWindow.picks) / frames, s_frameWindow.maxPicks,
+        static_cast<double>(s_frameWindow.micros) / frames, s_frameWindow.maxMicros);
+
+    for (size_t site = 0; site < static_cast<size_t>(QuerySite::kCount); ++site) {
+        SiteStats& stats = s_siteStats[site];
+        uint64_t picks = stats.picks;
+        uint64_t hits = stats.hits;
+        uint64_t micros = stats.totalMicros;
+        uint64_t buckets[LATENCY_BUCKET_COUNT];
+        std::copy(std::begin(stats.buckets), std::end(stats.buckets), buckets);
+        stats = SiteStats{};
+
+        if (picks == 0) {
+            continue;
+        }
+
+        std::string histogram;
+        for (size_t i = 0; i < LATENCY_BUCKET_COUNT; ++i) {
+            if (i > 0) {
+                histogram += '/';
+            }
+            histogram += std::to_string(buckets[i]);
+        }
+
+        spdlog::info("Raycast stats:   {:<28} {:>6} picks ({:.2f}/frame), {:5.1f}% hit, avg {:.1f}us, p50 {}, p95 {}, hist [{}]",
+            QUERY_SITE_NAMES[site], picks, static_cast<double>(picks) / frames,
+            100.0 * static_cast<double>(hits) / static_cast<double>(picks),
+            static_cast<double>(micros) / static_cast<double>(picks),
+            DescribePercentile(buckets, picks, 0.5), DescribePercentile(buckets, picks, 0.95), histogram);
+    }
+
+    s_frameWindow = FrameWindowStats{};
+    s_lastStatsLog = now;
+}
+#else
+// Instrumentation disabled - the timer compiles away
+struct PickTimer {
+    void Stop(bool) const {}
+    void StopBatch(std::span<const PhysicsQuery::QueryHit>) const {}
+};
+#endif
+
+// Backend queries are routed to - nullptr means the game's Havok world
+static PhysicsQuery::QueryBackend* s_backend = nullptr;
+static bool s_backendReportsRefs = true;  // Hit userData are TESObjectREFR*
+
+static PhysicsQuery::QueryBackend* GetActiveBackend() {
+    return s_backend ? s_backend : HavokQueryBackend::GetSingleton();
+}
+
+static PhysicsQuery::Vec3 ToVec3(const RE::NiPoint3& p) {
+    return PhysicsQuery::Vec3{ p.x, p.y, p.z };
+}
+
+static RE::NiPoint3 ToNiPoint(const PhysicsQuery::Vec3& v) {
+    return RE::NiPoint3{ v.x, v.y, v.z };
+}
+
+static PhysicsQuery::RayQuery ToRayQuery(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance,
+    CollisionLayerMask layerMask, RaycastOutputFlags outputs) {
+    return PhysicsQuery::RayQuery{ ToVec3(origin), ToVec3(direction), maxDistance, layerMask, outputs };
 }
 
-RaycastResult CastRay(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance, CollisionLayerMask layerMask) {
+static RaycastResult ToRaycastResult(const PhysicsQuery::QueryHit& hit) {
     RaycastResult result;
-    result.hit = false;
-    result.distance = maxDistance;
-    result.hitPoint = origin + direction * maxDistance;
-    result.hitNormal = {0.0f, 0.0f, 0.0f};
-    result.collisionLayer = RE::COL_LAYER::kUnidentified;
-    result.hitRef = nullptr;
+    result.hit = hit.hit;
+    result.distance = hit.distance;
+    result.hitPoint = ToNiPoint(hit.point);
+    result.hitNormal = ToNiPoint(hit.normal);
+    result.collisionLayer = hit.hit ? static_cast<RE::COL_LAYER>(hit.layer) : RE::COL_LAYER::kUnidentified;
+    // Only Havok (or a wrapper around it) reports game references
+    result.hitRef = hit.hit && s_backendReportsRefs ? static_cast<RE::TESObjectREFR*>(hit.userData) : nullptr;
+    return result;
+}
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player || !player->parentCell) {
-        return result;
+// Recorder results are handed to (SessionRecorder) - nullptr while not recording
+static QueryRecorder* s_recorder = nullptr;
+
+// Hand a result to the recorder as the climbing code sees it (hitRef only as "had one")
+static void RecordResult(SessionStream::QueryRecord& record, const RaycastResult& result) {
+    QueryRecorder* recorder = s_recorder;
+    if (!recorder) {
+        return;
     }
 
-    auto* physicsWorld = player->parentCell->GetbhkWorld();
-    if (!physicsWorld) {
-        return result;
+    record.hit.hit = result.hit;
+    record.hit.distance = result.distance;
+    record.hit.point = ToVec3(result.hitPoint);
+    record.hit.normal = ToVec3(result.hitNormal);
+    record.hit.layer = static_cast<uint32_t>(result.collisionLayer);
+    record.hadUserData = result.hitRef != nullptr;
+    recorder->Record(record);
+}
+
+static void RecordRay(const PhysicsQuery::RayQuery& query, const RaycastResult& result) {
+    if (!s_recorder) {
+        return;
     }
+    SessionStream::QueryRecord record;
+    record.kind = SessionStream::QueryKind::kRay;
+    record.ray = query;
+    RecordResult(record, result);
+}
 
-    float havokWorldScale = RE::bhkWorld::GetWorldScale();
+static void RecordMultiDirectional(const RE::NiPoint3& origin, float maxDistance, CollisionLayerMask layerMask,
+    RaycastOutputFlags outputs, const RaycastResult& result) {
+    if (!s_recorder) {
+        return;
+    }
+    SessionStream::QueryRecord record;
+    record.kind = SessionStream::QueryKind::kMultiDirectional;
+    record.ray = PhysicsQuery::RayQuery{ ToVec3(origin), PhysicsQuery::Vec3{}, maxDistance, layerMask, outputs };
+    RecordResult(record, result);
+}
 
-    // Iteratively cast rays, skipping layers that don't match the mask
-    // Each iteration starts just past the previous hit
-    constexpr int MAX_ITERATIONS = 8;  // Prevent infinite loops
-    constexpr float EPSILON = 0.01f;   // Small offset to avoid hitting the same object
+static void RecordCapsule(const PhysicsQuery::CapsuleSweep& sweep, const RaycastResult& result) {
+    if (!s_recorder) {
+        return;
+    }
+    SessionStream::QueryRecord record;
+    record.kind = SessionStream::QueryKind::kCapsule;
+    record.capsule = sweep;
+    RecordResult(record, result);
+}
 
-    float accumulatedDistance = 0.0f;
-    RE::NiPoint3 currentOrigin = origin;
+// Single ray that is answered from the per-frame cache when possible
+static RaycastResult CachedCastRay(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance,
+    CollisionLayerMask layerMask, RaycastOutputFlags outputs) {
+    bool useCache = IsCacheUsable();
+    QueryKey key{};
+    if (useCache) {
+        key = MakeQueryKey(origin, direction, maxDistance, layerMask);
+        RaycastResult cached;
+        if (FindCachedQuery(key, outputs, cached)) {
+            RecordRay(ToRayQuery(origin, direction, maxDistance, layerMask, outputs), cached);
+            return cached;
+        }
+    }
 
-    for (int i = 0; i < MAX_ITERATIONS; ++i) {
-        float remainingDistance = maxDistance - accumulatedDistance;
-        if (remainingDistance <= 0.0f) {
-            break;
+    PickTimer timer;
+    PhysicsQuery::QueryHit hit = GetActiveBackend()->CastRay(ToRayQuery(origin, direction, maxDistance, layerMask, outputs));
+    timer.Stop(hit.hit);
+
+    RaycastResult result = ToRaycastResult(hit);
+    if (useCache) {
+        s_frameCache.insert_or_assign(key, CachedQuery{ result, outputs });
+    }
+    RecordRay(ToRayQuery(origin, direction, maxDistance, layerMask, outputs), result);
+    return result;
+}
+
+RaycastResult CastRay(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance) {
+    return CastRay(origin, direction, maxDistance, LayerMasks::kAll);
+}
+
+RaycastResult CastRay(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance, CollisionLayerMask layerMask,
+    RaycastOutputFlags outputs) {
+    return CachedCastRay(origin, direction, maxDistance, layerMask, outputs);
+}
+
+// Rays handed to the backend per batch call - keeps the miss lists on the stack
+static constexpr size_t BATCH_CHUNK_SIZE = 16;
+
+void CastRays(std::span<const RaycastRequest> requests, std::span<RaycastResult> results) {
+    const size_t count = (std::min)(requests.size(), results.size());
+    if (count == 0) {
+        return;
+    }
+
+    bool useCache = IsCacheUsable();
+    auto* backend = GetActiveBackend();
+
+    for (size_t chunkStart = 0; chunkStart < count; chunkStart += BATCH_CHUNK_SIZE) {
+        size_t chunkEnd = (std::min)(count, chunkStart + BATCH_CHUNK_SIZE);
+
+        // Answer what we can from the cache, batch the rest
+        PhysicsQuery::RayQuery queries[BATCH_CHUNK_SIZE];
+        PhysicsQuery::QueryHit hits[BATCH_CHUNK_SIZE];
+        size_t missIndices[BATCH_CHUNK_SIZE];
+        QueryKey missKeys[BATCH_CHUNK_SIZE];
+        size_t missCount = 0;
+
+        for (size_t i = chunkStart; i < chunkEnd; ++i) {
+            const RaycastRequest& request = requests[i];
+            RaycastOutputFlags outputs = request.outputs;
+            if (useCache) {
+                QueryKey key = MakeQueryKey(request.origin, request.direction, request.maxDistance, request.layerMask);
+                if (FindCachedQuery(key, outputs, results[i])) {
+                    continue;
+                }
+                missKeys[missCount] = key;
+            }
+
+            queries[missCount] = ToRayQuery(request.origin, request.direction, request.maxDistance, request.layerMask, outputs);
+            missIndices[missCount] = i;
+            ++missCount;
         }
 
-        RE::NiPoint3 rayEnd = currentOrigin + direction * remainingDistance;
+        if (missCount == 0) {
+            continue;
+        }
 
-        RE::bhkPickData pickData;
-        pickData.rayInput.from = currentOrigin * havokWorldScale;
-        pickData.rayInput.to = rayEnd * havokWorldScale;
+        PickTimer timer;
+        backend->CastRays({ queries, missCount }, { hits, missCount });
+        timer.StopBatch({ hits, missCount });
 
-        physicsWorld->PickObject(pickData);
+        for (size_t m = 0; m < missCount; ++m) {
+            RaycastResult result = ToRaycastResult(hits[m]);
+            results[missIndices[m]] = result;
+            if (useCache) {
+                s_frameCache.insert_or_assign(missKeys[m], CachedQuery{ result, queries[m].outputs });
+            }
+        }
+    }
 
-        if (!pickData.rayOutput.HasHit()) {
-            // No more hits, we're done
-            break;
+    // Every result of the batch, cached or cast, in request order
+    if (s_recorder) {
+        for (size_t i = 0; i < count; ++i) {
+            const RaycastRequest& request = requests[i];
+            RecordRay(ToRayQuery(request.origin, request.direction, request.maxDistance, request.layerMask, request.outputs),
+                results[i]);
         }
+    }
+}
+
+RaycastResult CastMultiDirectionalRays(const RE::NiPoint3& origin, float maxDistance, CollisionLayerMask layerMask,
+    RaycastOutputFlags outputs) {
+    // Not cached - grab probes follow the hands and are rarely repeated within a frame
+    PickTimer timer;
+    PhysicsQuery::QueryHit hit = GetActiveBackend()->CastMultiDirectionalRays(ToVec3(origin), maxDistance, layerMask, outputs);
+    timer.Stop(hit.hit);
 
-        float hitFraction = pickData.rayOutput.hitFraction;
-        float hitDistance = remainingDistance * hitFraction;
-        RE::NiPoint3 hitPoint = currentOrigin + direction * hitDistance;
+    RaycastResult result = ToRaycastResult(hit);
+    RecordMultiDirectional(origin, maxDistance, layerMask, outputs, result);
+    return result;
+}
 
-        // Check if this hit is on a layer we care about
-        RE::COL_LAYER layer = RE::COL_LAYER::kUnidentified;
-        RE::TESObjectREFR* hitRef = nullptr;
+RaycastResult SweepCapsule(const RE::NiPoint3& segmentStart, const RE::NiPoint3& segmentEnd, float radius,
+    const RE::NiPoint3& direction, float maxDistance, CollisionLayerMask layerMask, RaycastOutputFlags outputs) {
+    // Not cached - the body moves every frame
+    PhysicsQuery::CapsuleSweep sweep{ ToVec3(segmentStart), ToVec3(segmentEnd), radius, ToVec3(direction), maxDistance,
+        layerMask, outputs };
+
+    PickTimer timer;
+    PhysicsQuery::QueryHit hit = GetActiveBackend()->SweepCapsule(sweep);
+    timer.Stop(hit.hit);
+
+    RaycastResult result = ToRaycastResult(hit);
+    RecordCapsule(sweep, result);
+    return result;
+}
 
-        if (pickData.rayOutput.rootCollidable) {
-            layer = pickData.rayOutput.rootCollidable->GetCollisionLayer();
-            hitRef = RE::TESHavokUtilities::FindCollidableRef(*pickData.rayOutput.rootCollidable);
+void SetBackend(PhysicsQuery::QueryBackend* backend, bool gameReferences) {
+    s_backend = backend;
+    s_backendReportsRefs = !backend || gameReferences;
+    s_frameCache.clear();  // Cached results belong to the previous world
+}
+
+PhysicsQuery::QueryBackend* GetBackend() {
+    return GetActiveBackend();
+}
+
+void SetRecorder(QueryRecorder* recorder) {
+    s_recorder = recorder;
+}
+
+// ===== Deferred queries =====
+
+// Rays that can be waiting (or resolved but unread) at once
+static constexpr size_t MAX_DEFERRED_QUERIES = 32;
+
+// Resolved results nobody reads for this many frames are dropped, so leaked tickets don't fill the queue
+static constexpr uint32_t DEFERRED_RESULT_LIFETIME_FRAMES = 300;
+
+enum class DeferredState : uint8_t {
+    kFree,
+    kPending,
+    kResolved
+};
+
+struct DeferredSlot {
+    QueryTicket ticket = kInvalidTicket;
+    DeferredState state = DeferredState::kFree;
+    uint32_t unreadFrames = 0;  // Frames since the result was resolved
+    RaycastRequest request;
+    RaycastResult result{};
+};
+
+static DeferredSlot s_deferredSlots[MAX_DEFERRED_QUERIES];
+static QueryTicket s_nextTicket = 1;
+static bool s_deferredStepRan = false;  // ResolveDeferred was called since the last BeginFrame
+
+static DeferredSlot* FindDeferredSlot(QueryTicket ticket) {
+    if (ticket == kInvalidTicket) {
+        return nullptr;
+    }
+    for (auto& slot : s_deferredSlots) {
+        if (slot.state != DeferredState::kFree && slot.ticket == ticket) {
+            return &slot;
         }
+    }
+    return nullptr;
+}
 
-        CollisionLayerMask layerBit = 1ULL << static_cast<uint64_t>(layer);
-        if ((layerMask & layerBit) != 0) {
-            // Found a hit on a matching layer!
-            result.hit = true;
-            result.distance = accumulatedDistance + hitDistance;
-            result.hitPoint = hitPoint;
-            result.hitNormal = {
-                pickData.rayOutput.normal.quad.m128_f32[0],
-                pickData.rayOutput.normal.quad.m128_f32[1],
-                pickData.rayOutput.normal.quad.m128_f32[2]
-            };
-            result.collisionLayer = layer;
-            result.hitRef = hitRef;
-            return result;
+QueryTicket SubmitDeferred(const RaycastRequest& request) {
+    for (auto& slot : s_deferredSlots) {
+        if (slot.state != DeferredState::kFree) {
+            continue;
         }
 
-        // Layer doesn't match - continue past this hit
-        accumulatedDistance += hitDistance + EPSILON;
-        currentOrigin = hitPoint + direction * EPSILON;
+        slot.ticket = s_nextTicket++;
+        if (s_nextTicket == kInvalidTicket) {
+            s_nextTicket = 1;
+        }
+        slot.state = DeferredState::kPending;
+        slot.request = request;
+        return slot.ticket;
     }
 
-    return result;
+    return kInvalidTicket;
+}
+
+bool TryGetDeferred(QueryTicket ticket, RaycastResult& outResult) {
+    DeferredSlot* slot = FindDeferredSlot(ticket);
+    if (!slot || slot->state != DeferredState::kResolved) {
+        return false;
+    }
+
+    outResult = slot->result;
+    slot->state = DeferredState::kFree;
+
+    const RaycastRequest& request = slot->request;
+    RecordRay(ToRayQuery(request.origin, request.direction, request.maxDistance, request.layerMask, request.outputs), outResult);
+    return true;
+}
+
+void CancelDeferred(QueryTicket ticket) {
+    if (DeferredSlot* slot = FindDeferredSlot(ticket)) {
+        slot->state = DeferredState::kFree;
+    }
+}
+
+void ResolveDeferred() {
+    s_deferredStepRan = true;
+
+    PhysicsQuery::RayQuery queries[MAX_DEFERRED_QUERIES];
+    PhysicsQuery::QueryHit hits[MAX_DEFERRED_QUERIES];
+    DeferredSlot* pending[MAX_DEFERRED_QUERIES];
+    size_t count = 0;
+
+    for (auto& slot : s_deferredSlots) {
+        if (slot.state == DeferredState::kPending) {
+            const RaycastRequest& request = slot.request;
+            queries[count] = ToRayQuery(request.origin, request.direction, request.maxDistance, request.layerMask, request.outputs);
+            pending[count] = &slot;
+            ++count;
+        }
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    RAYCAST_QUERY_SITE(kDeferredBatch);
+    PickTimer timer;
+    GetActiveBackend()->CastRays({ queries, count }, { hits, count });
+    timer.StopBatch({ hits, count });
+
+    for (size_t i = 0; i < count; ++i) {
+        pending[i]->result = ToRaycastResult(hits[i]);
+        pending[i]->unreadFrames = 0;
+        pending[i]->state = DeferredState::kResolved;
+    }
+}
+
+// Drop results that have gone unread for too long
+static void ExpireDeferredResults() {
+    for (auto& slot : s_deferredSlots) {
+        if (slot.state == DeferredState::kResolved && ++slot.unreadFrames > DEFERRED_RESULT_LIFETIME_FRAMES) {
+            spdlog::debug("Raycast: Dropping unread deferred result (ticket {})", slot.ticket);
+            slot.state = DeferredState::kFree;
+        }
+    }
+}
+
+// No physics step last frame (menu open, no loaded world, HIGGS missing) - resolve what is pending here,
+// so the rays still get answered and their slots don't stay taken
+static void FlushDeferredWithoutStep() {
+    if (!s_deferredStepRan) {
+        ResolveDeferred();
+    }
+    s_deferredStepRan = false;
+}
+
+void BeginFrame() {
+    ExpireDeferredResults();
+    FlushDeferredWithoutStep();
+    s_frameCache.clear();  // Keeps bucket storage, so steady-state frames don't allocate buckets
+    s_inFrame = true;
+
+    if (++s_frameEpoch % CACHE_LOG_INTERVAL_FRAMES == 0) {
+        uint64_t hits = s_cacheStats.hits - s_cacheStatsAtLastLog.hits;
+        uint64_t misses = s_cacheStats.misses - s_cacheStatsAtLastLog.misses;
+        if (hits + misses > 0) {
+            spdlog::debug("Raycast: cache {} hits / {} misses over last {} frames ({:.1f}% of picks saved)",
+                hits, misses, CACHE_LOG_INTERVAL_FRAMES,
+                100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses));
+        }
+        s_cacheStatsAtLastLog = s_cacheStats;
+    }
+
+#ifdef VRCLIMBING_RAYCAST_STATS
+    UpdateQueryStats();
+#endif
+}
+
+void EndFrame() {
+    s_inFrame = false;
+}
+
+CacheStats GetCacheStats() {
+    return s_cacheStats;
 }
 
 float GetAllowedDistance(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance, float buffer) {
-    RaycastResult rayResult = CastRay(origin, direction, maxDistance + buffer);
+    // Only the distance is read
+    RaycastResult rayResult = CastRay(origin, direction, maxDistance + buffer, LayerMasks::kAll, RaycastOutputs::kNone);
 
     if (rayResult.hit) {
         // Wall found, limit movement to (distance - buffer), minimum 0
@@ -156,7 +690,7 @@ float GetAllowedDistance(const RE::NiPoint3& origin, const RE::NiPoint3& directi
 }
 
 float GetAllowedDistance(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance, float buffer, LayerFilter layerFilter) {
-    RaycastResult rayResult = CastRay(origin, direction, maxDistance + buffer);
+    RaycastResult rayResult = CastRay(origin, direction, maxDistance + buffer, LayerMasks::kAll, RaycastOutputs::kLayer);
 
     // Only consider hits on layers that pass the filter
     if (rayResult.hit && layerFilter(rayResult.collisionLayer)) {
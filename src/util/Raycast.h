@@ -1,6 +1,10 @@
 #pragma once
 
 #include "RE/Skyrim.h"
+#include "QueryBackend.h"
+#include <span>
+
+class QueryRecorder;
 
 // Layer mask for collision layer filtering
 // Each bit corresponds to a COL_LAYER value (0-46)
@@ -34,6 +38,24 @@ namespace LayerMasks {
         MakeLayerMask(RE::COL_LAYER::kClutterLarge) |
         MakeLayerMask(RE::COL_LAYER::kDebrisSmall) |
         MakeLayerMask(RE::COL_LAYER::kDebrisLarge);
+
+    // Every layer - accepts the closest hit regardless of layer (same as the unmasked CastRay)
+    constexpr CollisionLayerMask kAll = ~0ULL;
+}
+
+// Optional hit fields a query fills in - hit, distance and hitPoint are always filled
+// Fields that aren't requested may be left at their defaults (zero normal, kUnidentified, nullptr).
+// hitRef costs a collidable -> reference walk on every hit, so only ask for it where it's read.
+using RaycastOutputFlags = PhysicsQuery::OutputFlags;
+
+namespace RaycastOutputs {
+    constexpr RaycastOutputFlags kNone = 0;  // Only hit/distance/hitPoint
+    constexpr RaycastOutputFlags kNormal = PhysicsQuery::kOutputNormal;
+    constexpr RaycastOutputFlags kLayer = PhysicsQuery::kOutputLayer;
+    constexpr RaycastOutputFlags kHitRef = PhysicsQuery::kOutputUserData;
+
+    // Everything - what the plain CastRay overloads ask for
+    constexpr RaycastOutputFlags kAll = kNormal | kLayer | kHitRef;
 }
 
 struct RaycastResult {
@@ -45,7 +67,77 @@ struct RaycastResult {
     RE::TESObjectREFR* hitRef;     // The object reference that was hit (may be nullptr)
 };
 
+// One ray of a batched query (see Raycast::CastRays)
+struct RaycastRequest {
+    RE::NiPoint3 origin;
+    RE::NiPoint3 direction;                      // Must be normalized
+    float maxDistance = 0.0f;                    // Game units
+    CollisionLayerMask layerMask = LayerMasks::kAll;
+    RaycastOutputFlags outputs = RaycastOutputs::kAll;
+};
+
+// Parameters of a Raycast::SweepCapsule call, for code that builds a sweep before casting it
+struct CapsuleSweepRequest {
+    RE::NiPoint3 segmentStart;
+    RE::NiPoint3 segmentEnd;
+    float radius = 0.0f;
+    RE::NiPoint3 direction;                      // Must be normalized
+    float maxDistance = 0.0f;                    // Game units
+    CollisionLayerMask layerMask = LayerMasks::kAll;
+    RaycastOutputFlags outputs = RaycastOutputs::kAll;
+};
+
 namespace Raycast {
+    // ===== Query instrumentation =====
+    // Built with VRCLIMBING_RAYCAST_STATS defined, every backend query is attributed to the call site
+    // that is active when it is issued (see RAYCAST_QUERY_SITE) and its count, hit rate and
+    // latency are summarized to the log periodically. Without it, the tags compile to nothing.
+
+    // Call sites that issue physics queries - keep in sync with the name table in Raycast.cpp
+    enum class QuerySite : uint8_t {
+        kUntagged,
+        kSurfaceDetectorRays,         // Grab probe's 6 cardinal rays around the hand
+        kSurfaceDetectorHMD,          // HMD-to-hand fallback ray of the grab probe
+        kSurfaceDetectorDirectional,  // Single-direction hand ray
+        kAutoCatch,                   // Mid-air / post-flight auto-catch probes
+        kClimbSweep,                  // Body sweep (walls and floor) in ApplyClimbMovement
+        kGhostPath,                   // Clear-path check before entering ghost mode
+        kGhostFloor,                  // Floor penetration check during ghost mode
+        kLandingPenetration,          // Ground check forcing exit correction on landing
+        kLandingPrediction,           // PredictLandingPosition ground steps
+        kExitDetect,                  // Exit correction detection and headroom
+        kExitEscape,                  // Horizontal escape search
+        kExitSafePosition,            // Periodic safe position check
+        kCriticalImpact,              // Critical strike impact ray
+        kDeferredBatch,               // Deferred rays resolved in the pre-physics step
+        kCount
+    };
+
+#ifdef VRCLIMBING_RAYCAST_STATS
+    // Set the call site for the queries that follow, returning the previous one
+    QuerySite SetQuerySite(QuerySite site);
+
+    // Tags every query in the enclosing scope with a call site
+    class ScopedQuerySite {
+    public:
+        explicit ScopedQuerySite(QuerySite site) : m_previous(SetQuerySite(site)) {}
+        ~ScopedQuerySite() { SetQuerySite(m_previous); }
+        ScopedQuerySite(const ScopedQuerySite&) = delete;
+        ScopedQuerySite& operator=(const ScopedQuerySite&) = delete;
+
+    private:
+        QuerySite m_previous;
+    };
+
+    // Innermost tag wins, so a scope may re-tag a later query
+    #define RAYCAST_QUERY_SITE_CONCAT_IMPL(a, b) a##b
+    #define RAYCAST_QUERY_SITE_CONCAT(a, b) RAYCAST_QUERY_SITE_CONCAT_IMPL(a, b)
+    #define RAYCAST_QUERY_SITE(site) \
+        ::Raycast::ScopedQuerySite RAYCAST_QUERY_SITE_CONCAT(raycastQuerySite, __LINE__)(::Raycast::QuerySite::site)
+#else
+    #define RAYCAST_QUERY_SITE(site) ((void)0)
+#endif
+
     // Layer filter function type - returns true if the layer should block movement
     using LayerFilter = bool(*)(RE::COL_LAYER);
 
@@ -54,9 +146,96 @@ namespace Raycast {
     RaycastResult CastRay(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance);
 
     // Cast a ray that only hits layers matching the given mask
-    // Uses a custom collector that filters by collision layer during the raycast
+    // Uses a custom collector that filters by collision layer during the raycast, so
+    // geometry on other layers (clutter, actors, triggers) is skipped in a single Havok traversal
     // layerMask: bitmask of acceptable layers (use LayerMasks::kSolid or MakeLayerMask())
-    RaycastResult CastRay(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance, CollisionLayerMask layerMask);
+    // outputs: hit fields the caller reads (see RaycastOutputs)
+    RaycastResult CastRay(const RE::NiPoint3& origin, const RE::NiPoint3& direction, float maxDistance, CollisionLayerMask layerMask,
+        RaycastOutputFlags outputs = RaycastOutputs::kAll);
+
+    // Cast several rays in one call - results[i] is filled for requests[i]
+    // The physics world lookup, world scale and world read lock are taken once for the whole batch,
+    // so multi-ray probes (grab detection, escape searches) should prefer this over repeated CastRay
+    // results must be at least as large as requests; extra entries are left untouched
+    void CastRays(std::span<const RaycastRequest> requests, std::span<RaycastResult> results);
+
+    // Cast the grab probe's 6 cardinal rays (+-X, +-Y, +-Z) from origin, maxDistance long, on layers matching
+    // the mask, and return the nearest hit. These are the same picks the grab check always made - only the
+    // nearest hit is now reported instead of the first climbable one. Not a sphere query: surfaces between the
+    // axes are missed, and a collider that already encloses origin is not reported
+    RaycastResult CastMultiDirectionalRays(const RE::NiPoint3& origin, float maxDistance, CollisionLayerMask layerMask,
+        RaycastOutputFlags outputs = RaycastOutputs::kAll);
+
+    // Sweep a capsule (axis segmentStart-segmentEnd, radius) along direction for up to maxDistance
+    // Returns the first contact on layers matching the mask: distance is how far the capsule travels
+    // before touching, hitPoint/hitNormal are the contact. No hit = the whole sweep is clear.
+    // The Havok backend casts one ray from each end cap's center as one batch (see QueryBackend::SweepCapsule)
+    RaycastResult SweepCapsule(const RE::NiPoint3& segmentStart, const RE::NiPoint3& segmentEnd, float radius,
+        const RE::NiPoint3& direction, float maxDistance, CollisionLayerMask layerMask,
+        RaycastOutputFlags outputs = RaycastOutputs::kAll);
+
+    // ===== Per-frame query cache =====
+    // Queries issued during the frame update are memoized for the rest of it, keyed on
+    // quantized origin/direction/length/layer mask, so near-identical rays cast by different
+    // managers in the same frame cost one Havok pick. A cached result answers any query whose
+    // output flags it covers. Queries outside the update (the physics pre-step, which runs after
+    // the world has moved) bypass the cache.
+
+    // Advance the frame epoch, dropping all cached results. Call at the start of the frame update.
+    void BeginFrame();
+
+    // Stop caching until the next BeginFrame. Call at the end of the frame update.
+    void EndFrame();
+
+    struct CacheStats {
+        uint64_t hits = 0;    // Queries answered from the cache
+        uint64_t misses = 0;  // Queries that went to Havok
+    };
+
+    // Totals since plugin load
+    CacheStats GetCacheStats();
+
+    // ===== Deferred queries =====
+    // Rays that aren't latency-critical can be submitted instead of cast on the spot. Pending rays are
+    // resolved together as one batch in the physics pre-step (ResolveDeferred, driven by the HIGGS
+    // pre-physics callback) and the result is read on a later main-thread tick. Rays still pending after a
+    // frame with no physics step are resolved at the start of the next frame (BeginFrame) instead.
+    // Deferred rays bypass the per-frame cache.
+
+    using QueryTicket = uint32_t;
+    constexpr QueryTicket kInvalidTicket = 0;
+
+    // Queue a ray for the next pre-physics batch
+    // Returns kInvalidTicket if the queue is full - cast synchronously instead
+    QueryTicket SubmitDeferred(const RaycastRequest& request);
+
+    // If the ticket's ray has been resolved, copies the result, releases the ticket and returns true
+    // Returns false while the ray is still pending, or for unknown/expired tickets
+    // Results that are not read within a few seconds are discarded
+    bool TryGetDeferred(QueryTicket ticket, RaycastResult& outResult);
+
+    // Release a ticket without reading it (a pending ray is dropped)
+    void CancelDeferred(QueryTicket ticket);
+
+    // Resolve every pending deferred ray in one backend batch. Called from the physics pre-step.
+    void ResolveDeferred();
+
+    // ===== Backend =====
+    // Every query goes through a PhysicsQuery::QueryBackend - the game's Havok world by default.
+    // Pointing this at another backend (e.g. tools/replay's MeshQueryBackend) runs the same query code against a
+    // stand-in world. nullptr restores Havok.
+    // hitRef is only reported when the backend's userData are game references: always for Havok, and for
+    // a wrapper around it when gameReferences is set.
+    // Switch only from the frame update, not while a deferred batch is resolving.
+    void SetBackend(PhysicsQuery::QueryBackend* backend, bool gameReferences = false);
+
+    PhysicsQuery::QueryBackend* GetBackend();
+
+    // ===== Recording =====
+    // While a recorder is set, every result returned by the queries above is handed to it along with the
+    // query - cache hits and deferred results as read through TryGetDeferred included (SessionRecorder).
+    // nullptr stops recording.
+    void SetRecorder(QueryRecorder* recorder);
 
     // Check if movement in a direction is blocked by geometry
     // Returns the allowed distance (clamped to maxDistance if no obstacle, or distance to wall minus buffer)
@@ -0,0 +1,331 @@
+#include "SessionStream.h"
+#include <cstring>
+#include <type_traits>
+
+namespace SessionStream {
+
+using PhysicsQuery::CapsuleSweep;
+using PhysicsQuery::QueryHit;
+using PhysicsQuery::RayQuery;
+using PhysicsQuery::Vec3;
+
+// Largest frame block a reader accepts - guards against reading garbage sizes from a damaged file
+static constexpr uint32_t MAX_FRAME_BYTES = 16u * 1024u * 1024u;
+
+// QueryHit flag byte
+static constexpr uint8_t HIT_FLAG_HIT = 1 << 0;
+static constexpr uint8_t HIT_FLAG_USER_DATA = 1 << 1;
+
+// ===== Encoding =====
+
+template <typename T>
+static void Put(std::vector<uint8_t>& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+static void PutVec3(std::vector<uint8_t>& out, const Vec3& v) {
+    Put(out, v.x);
+    Put(out, v.y);
+    Put(out, v.z);
+}
+
+static void PutTransform(std::vector<uint8_t>& out, const Transform& t) {
+    for (const auto& row : t.rotate) {
+        for (float value : row) {
+            Put(out, value);
+        }
+    }
+    PutVec3(out, t.translate);
+}
+
+static void PutHit(std::vector<uint8_t>& out, const QueryHit& hit, bool hadUserData) {
+    uint8_t flags = (hit.hit ? HIT_FLAG_HIT : 0) | (hadUserData ? HIT_FLAG_USER_DATA : 0);
+    Put(out, flags);
+    Put(out, hit.distance);
+    if (!hit.hit) {
+        return;  // Point is origin + direction * distance; normal and layer are unused
+    }
+    PutVec3(out, hit.point);
+    PutVec3(out, hit.normal);
+    Put(out, hit.layer);
+}
+
+static void PutQuery(std::vector<uint8_t>& out, const QueryRecord& query) {
+    Put(out, static_cast<uint8_t>(query.kind));
+    if (query.kind == QueryKind::kCapsule) {
+        const CapsuleSweep& sweep = query.capsule;
+        PutVec3(out, sweep.segmentStart);
+        PutVec3(out, sweep.segmentEnd);
+        Put(out, sweep.radius);
+        PutVec3(out, sweep.direction);
+        Put(out, sweep.maxDistance);
+        Put(out, sweep.layerMask);
+        Put(out, sweep.outputs);
+    } else {
+        const RayQuery& ray = query.ray;
+        PutVec3(out, ray.origin);
+        if (query.kind == QueryKind::kRay) {
+            PutVec3(out, ray.direction);
+        }
+        Put(out, ray.maxDistance);
+        Put(out, ray.layerMask);
+        Put(out, ray.outputs);
+    }
+    PutHit(out, query.hit, query.hadUserData);
+}
+
+// ===== Decoding =====
+
+// Bounds-checked read cursor over one frame payload - any overrun marks the block as bad
+struct Cursor {
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool ok = true;
+
+    template <typename T>
+    T Get() {
+        T value{};
+        if (!ok || size - offset < sizeof(T)) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    Vec3 GetVec3() {
+        Vec3 v;
+        v.x = Get<float>();
+        v.y = Get<float>();
+        v.z = Get<float>();
+        return v;
+    }
+
+    Transform GetTransform() {
+        Transform t;
+        for (auto& row : t.rotate) {
+            for (float& value : row) {
+                value = Get<float>();
+            }
+        }
+        t.translate = GetVec3();
+        return t;
+    }
+};
+
+static void GetHit(Cursor& in, const Vec3& origin, const Vec3& direction, QueryRecord& outQuery) {
+    uint8_t flags = in.Get<uint8_t>();
+    QueryHit& hit = outQuery.hit;
+    hit.hit = (flags & HIT_FLAG_HIT) != 0;
+    hit.distance = in.Get<float>();
+    outQuery.hadUserData = (flags & HIT_FLAG_USER_DATA) != 0;
+    if (!hit.hit) {
+        hit.point = origin + direction * hit.distance;
+        return;
+    }
+    hit.point = in.GetVec3();
+    hit.normal = in.GetVec3();
+    hit.layer = in.Get<uint32_t>();
+}
+
+static void GetQuery(Cursor& in, QueryRecord& outQuery) {
+    outQuery = QueryRecord{};
+    uint8_t kind = in.Get<uint8_t>();
+    if (kind > static_cast<uint8_t>(QueryKind::kCapsule)) {
+        in.ok = false;
+        return;
+    }
+    outQuery.kind = static_cast<QueryKind>(kind);
+
+    if (outQuery.kind == QueryKind::kCapsule) {
+        CapsuleSweep& sweep = outQuery.capsule;
+        sweep.segmentStart = in.GetVec3();
+        sweep.segmentEnd = in.GetVec3();
+        sweep.radius = in.Get<float>();
+        sweep.direction = in.GetVec3();
+        sweep.maxDistance = in.Get<float>();
+        sweep.layerMask = in.Get<PhysicsQuery::LayerMask>();
+        sweep.outputs = in.Get<PhysicsQuery::OutputFlags>();
+        GetHit(in, sweep.segmentStart, sweep.direction, outQuery);
+        return;
+    }
+
+    RayQuery& ray = outQuery.ray;
+    ray.origin = in.GetVec3();
+    if (outQuery.kind == QueryKind::kRay) {
+        ray.direction = in.GetVec3();
+    }
+    ray.maxDistance = in.Get<float>();
+    ray.layerMask = in.Get<PhysicsQuery::LayerMask>();
+    ray.outputs = in.Get<PhysicsQuery::OutputFlags>();
+    GetHit(in, ray.origin, ray.direction, outQuery);  // 6-ray probes have no direction - a miss reports the origin
+}
+
+// ===== Writer =====
+
+bool Writer::Open(const std::string& path)
+{
+    Close();
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        return false;
+    }
+
+    uint32_t header[2] = { kMagic, kVersion };
+    if (std::fwrite(header, sizeof(header), 1, m_file) != 1) {
+        Close();
+        return false;
+    }
+    m_bytesWritten = sizeof(header);
+    return true;
+}
+
+void Writer::Close()
+{
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool Writer::Write(const Frame& frame)
+{
+    if (!m_file) {
+        return false;
+    }
+
+    m_buffer.clear();
+
+    const FrameInput& input = frame.input;
+    Put(m_buffer, input.frameNumber);
+    Put(m_buffer, input.deltaTime);
+    Put(m_buffer, input.nodes);
+    // Transforms of missing nodes are left out
+    if (input.nodes & kHasHmd) {
+        PutTransform(m_buffer, input.hmd);
+    }
+    if (input.nodes & kHasLeftHand) {
+        PutTransform(m_buffer, input.leftHand);
+    }
+    if (input.nodes & kHasRightHand) {
+        PutTransform(m_buffer, input.rightHand);
+    }
+    PutVec3(m_buffer, input.controllerVelocity);
+    Put(m_buffer, input.support);
+    Put(m_buffer, input.gripPressed);
+    Put(m_buffer, input.gripReleased);
+
+    const FrameOutcome& outcome = frame.outcome;
+    PutVec3(m_buffer, outcome.playerPosition);
+    Put(m_buffer, outcome.state);
+    Put(m_buffer, outcome.updateMicros);
+
+    Put(m_buffer, static_cast<uint32_t>(frame.queries.size()));
+    for (const auto& query : frame.queries) {
+        PutQuery(m_buffer, query);
+    }
+
+    uint32_t size = static_cast<uint32_t>(m_buffer.size());
+    if (std::fwrite(&size, sizeof(size), 1, m_file) != 1 ||
+        std::fwrite(m_buffer.data(), m_buffer.size(), 1, m_file) != 1) {
+        Close();
+        return false;
+    }
+
+    m_bytesWritten += sizeof(size) + m_buffer.size();
+    return true;
+}
+
+// ===== Reader =====
+
+bool Reader::Open(const std::string& path)
+{
+    Close();
+    m_error = false;
+    m_file = std::fopen(path.c_str(), "rb");
+    if (!m_file) {
+        return false;
+    }
+
+    uint32_t header[2] = {};
+    if (std::fread(header, sizeof(header), 1, m_file) != 1 || header[0] != kMagic || header[1] != kVersion) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void Reader::Close()
+{
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool Reader::Next(Frame& outFrame)
+{
+    if (!m_file) {
+        return false;
+    }
+
+    uint32_t size = 0;
+    if (std::fread(&size, sizeof(size), 1, m_file) != 1) {
+        m_error = !std::feof(m_file);
+        return false;
+    }
+    if (size > MAX_FRAME_BYTES) {
+        m_error = true;
+        return false;
+    }
+
+    m_buffer.resize(size);
+    if (size > 0 && std::fread(m_buffer.data(), size, 1, m_file) != 1) {
+        m_error = true;  // Truncated - e.g. the game exited mid-write
+        return false;
+    }
+
+    Cursor in{ m_buffer.data(), m_buffer.size() };
+
+    FrameInput& input = outFrame.input;
+    input = FrameInput{};
+    input.frameNumber = in.Get<uint32_t>();
+    input.deltaTime = in.Get<float>();
+    input.nodes = in.Get<uint8_t>();
+    if (input.nodes & kHasHmd) {
+        input.hmd = in.GetTransform();
+    }
+    if (input.nodes & kHasLeftHand) {
+        input.leftHand = in.GetTransform();
+    }
+    if (input.nodes & kHasRightHand) {
+        input.rightHand = in.GetTransform();
+    }
+    input.controllerVelocity = in.GetVec3();
+    input.support = in.Get<uint8_t>();
+    input.gripPressed = in.Get<uint8_t>();
+    input.gripReleased = in.Get<uint8_t>();
+
+    FrameOutcome& outcome = outFrame.outcome;
+    outcome.playerPosition = in.GetVec3();
+    outcome.state = in.Get<uint8_t>();
+    outcome.updateMicros = in.Get<float>();
+
+    uint32_t queryCount = in.Get<uint32_t>();
+    outFrame.queries.clear();
+    for (uint32_t i = 0; i < queryCount && in.ok; ++i) {
+        GetQuery(in, outFrame.queries.emplace_back());
+    }
+
+    if (!in.ok || in.offset != in.size) {
+        m_error = true;
+        return false;
+    }
+    return true;
+}
+
+} // namespace SessionStream
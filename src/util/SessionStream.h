@@ -0,0 +1,146 @@
+#pragma once
+
+// Binary climbing session stream (see SessionRecorder)
+// One block per rendered frame: the tracked inputs the climbing code read (VR node transforms, dt,
+// grip edges, character controller velocity and support), what came out of the frame (player
+// position, climb/flight state, update time) and every query result Raycast returned to the climbing
+// code during it, per-frame cache hits included.
+// Like QueryBackend.h this is free of CommonLib/Windows types, so the offline replayer
+// (tools/replay) reads the stream on any platform.
+//
+// Layout: file header (magic, version), then per frame a u32 payload size followed by the payload.
+// Values are written in native byte order - streams are recorded and read on little-endian x64.
+// Queries are written field by field; misses store only the distance, so a frame of grab probes
+// costs a few hundred bytes.
+
+#include "QueryBackend.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace SessionStream {
+
+constexpr uint32_t kMagic = 0x53435256;  // "VRCS"
+constexpr uint32_t kVersion = 1;
+
+struct Transform {
+    float rotate[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+    PhysicsQuery::Vec3 translate;
+};
+
+// FrameInput::nodes - which VR node transforms were available
+enum NodeFlags : uint8_t {
+    kHasHmd = 1 << 0,
+    kHasLeftHand = 1 << 1,
+    kHasRightHand = 1 << 2
+};
+
+// FrameInput::gripPressed / gripReleased - grip edges delivered this frame
+enum GripFlags : uint8_t {
+    kLeftGrip = 1 << 0,
+    kRightGrip = 1 << 1
+};
+
+// FrameInput::support - character controller ground contact
+enum SupportFlags : uint8_t {
+    kHasSupportBody = 1 << 0,  // supportBody set
+    kSupported = 1 << 1        // surfaceInfo reports kSupported
+};
+
+// FrameOutcome::state - climbing systems active at the end of the frame
+enum StateFlags : uint8_t {
+    kLeftGrabbing = 1 << 0,
+    kRightGrabbing = 1 << 1,
+    kInFlight = 1 << 2,
+    kCorrecting = 1 << 3
+};
+
+struct FrameInput {
+    uint32_t frameNumber = 0;
+    float deltaTime = 0.0f;
+    uint8_t nodes = 0;
+    Transform hmd;
+    Transform leftHand;
+    Transform rightHand;
+    PhysicsQuery::Vec3 controllerVelocity;  // Game units/s
+    uint8_t support = 0;
+    uint8_t gripPressed = 0;
+    uint8_t gripReleased = 0;
+};
+
+struct FrameOutcome {
+    PhysicsQuery::Vec3 playerPosition;
+    uint8_t state = 0;
+    float updateMicros = 0.0f;  // Time spent in the climbing frame update
+};
+
+enum class QueryKind : uint8_t {
+    kRay,
+    kMultiDirectional,  // 6 cardinal rays: ray.origin, ray.maxDistance (no direction)
+    kCapsule
+};
+
+struct QueryRecord {
+    QueryKind kind = QueryKind::kRay;
+    PhysicsQuery::RayQuery ray;          // kRay, kMultiDirectional
+    PhysicsQuery::CapsuleSweep capsule;  // kCapsule
+    PhysicsQuery::QueryHit hit;          // userData is not recorded - a read hit only tells whether it had one
+    bool hadUserData = false;
+};
+
+struct Frame {
+    FrameInput input;
+    FrameOutcome outcome;
+    std::vector<QueryRecord> queries;
+};
+
+class Writer
+{
+public:
+    Writer() = default;
+    ~Writer() { Close(); }
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    // Create (or truncate) the file and write the header
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_file != nullptr; }
+
+    // Append one frame block - returns false if the write failed (the stream is closed)
+    bool Write(const Frame& frame);
+
+    uint64_t GetBytesWritten() const { return m_bytesWritten; }
+
+private:
+    std::FILE* m_file = nullptr;
+    std::vector<uint8_t> m_buffer;  // Payload of the frame being written, reused across frames
+    uint64_t m_bytesWritten = 0;
+};
+
+class Reader
+{
+public:
+    Reader() = default;
+    ~Reader() { Close(); }
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // Open a stream and check its header
+    bool Open(const std::string& path);
+    void Close();
+
+    // Read the next frame block - false at the end of the stream or on a malformed block
+    bool Next(Frame& outFrame);
+
+    // True if Next stopped on a malformed or truncated block rather than the end of the stream
+    bool HasError() const { return m_error; }
+
+private:
+    std::FILE* m_file = nullptr;
+    std::vector<uint8_t> m_buffer;
+    bool m_error = false;
+};
+
+} // namespace SessionStream
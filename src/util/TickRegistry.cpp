@@ -0,0 +1,45 @@
+#include "TickRegistry.h"
+#include <cstddef>
+
+namespace TickRegistry {
+
+static_assert(static_cast<size_t>(Tick::kCount) <= 32, "Subscriptions are a 32-bit mask");
+
+static TickFunc s_funcs[static_cast<size_t>(Tick::kCount)] = {};
+static uint32_t s_subscribed = 0;
+
+static uint32_t Bit(Tick tick) {
+    return 1u << static_cast<uint32_t>(tick);
+}
+
+void Register(Tick tick, TickFunc func) {
+    s_funcs[static_cast<size_t>(tick)] = func;
+}
+
+void Subscribe(Tick tick) {
+    s_subscribed |= Bit(tick);
+}
+
+void Unsubscribe(Tick tick) {
+    s_subscribed &= ~Bit(tick);
+}
+
+bool IsSubscribed(Tick tick) {
+    return (s_subscribed & Bit(tick)) != 0;
+}
+
+void RunFrame(const FrameContext& frame) {
+    // Nothing active - the common case while the player is walking around
+    if (s_subscribed == 0) {
+        return;
+    }
+
+    // The mask is re-read for every tick, so subscriptions made by an earlier tick this frame are honored
+    for (size_t i = 0; i < static_cast<size_t>(Tick::kCount); ++i) {
+        if ((s_subscribed & (1u << i)) != 0 && s_funcs[i]) {
+            s_funcs[i](frame);
+        }
+    }
+}
+
+} // namespace TickRegistry
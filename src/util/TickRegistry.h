@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+struct FrameContext;
+
+// Per-frame updates that only run while their owner has work (a flight, a correction, a pending restore)
+// Owners subscribe when the work starts and unsubscribe once it is done, so a frame where nothing is
+// active costs one check of the subscription mask. ClimbManager registers the update functions and runs
+// the subscribed ones once per frame from its main thread hook.
+// Everything here is main thread only - that includes the physics pre-step, which HIGGS calls from
+// bhkWorld::Update right before hkpWorld::stepDeltaTime (a grip release there may subscribe a flight).
+namespace TickRegistry {
+
+// Updates in run order - an update that starts another's work (a landing starting an exit correction)
+// has that one run the same frame
+enum class Tick : uint8_t {
+    kBallisticFlight,  // BallisticController flight and the post-flight auto-catch window (ClimbManager)
+    kCriticalStrike,   // CriticalStrikeManager while in flight or slow-mo is active
+    kExitCorrection,   // ClimbExitCorrector while a correction is running
+    kHiggsRestore,     // HiggsCompatManager while a settings restore is pending
+    kCount
+};
+
+using TickFunc = void(*)(const FrameContext& frame);
+
+// Set the function a tick runs - once, at initialization
+void Register(Tick tick, TickFunc func);
+
+// Start running the tick every frame, from this frame's RunFrame if it hasn't reached it yet
+void Subscribe(Tick tick);
+
+// Stop running the tick (a tick may unsubscribe itself while it runs)
+void Unsubscribe(Tick tick);
+
+bool IsSubscribed(Tick tick);
+
+// Run the subscribed ticks in order. Call once per frame on the main thread.
+void RunFrame(const FrameContext& frame);
+
+} // namespace TickRegistry
@@ -0,0 +1,225 @@
+#include "ClimbReplay.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+using PhysicsQuery::Vec3;
+using SessionStream::Frame;
+using SessionStream::FrameInput;
+
+// ClimbManager::UpdateClimbing caps a step at this
+static constexpr float MAX_DELTA = 0.1f;
+
+static std::string Trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return {};
+    }
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+// Where ClimbManager::GetHandWorldPosition would put the hand - the player position if the node wasn't there
+static Vec3 HandPosition(const FrameInput& input, bool isLeft, const Vec3& playerPos) {
+    uint8_t flag = isLeft ? SessionStream::kHasLeftHand : SessionStream::kHasRightHand;
+    if (!(input.nodes & flag)) {
+        return playerPos;
+    }
+    return isLeft ? input.leftHand.translate : input.rightHand.translate;
+}
+
+bool ClimbReplay::LoadSettings(const std::string& path, Settings& outSettings)
+{
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    std::string section;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = Trim(line);
+        if (line.empty() || line[0] == ';' || line[0] == '#') {
+            continue;
+        }
+        if (line[0] == '[') {
+            section = Trim(line.substr(1, line.find(']') - 1));
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            continue;
+        }
+        std::string key = Trim(line.substr(0, equals));
+        float value = std::strtof(line.c_str() + equals + 1, nullptr);
+
+        if (section == "Climbing") {
+            if (key == "fixedStepRate") {
+                outSettings.fixedStepRate = static_cast<int>(value);
+            } else if (key == "maxVelocitySamples") {
+                outSettings.maxVelocitySamples = static_cast<int>(value);
+            } else if (key == "velocityHistoryTime") {
+                outSettings.velocityHistoryTime = value;
+            } else if (key == "velocityWeightExponent") {
+                outSettings.velocityWeightExponent = value;
+            } else if (key == "launchDirectionFilter") {
+                outSettings.launchDirectionFilter = value;
+            }
+        } else if (section == "ClimbingAbility") {
+            if (key == "smoothingMode") {
+                outSettings.smoothing.mode = static_cast<int>(value);
+            } else if (key == "smoothingSpeed") {
+                outSettings.smoothing.speed = value;
+            } else if (key == "oneEuroMinCutoff") {
+                outSettings.smoothing.oneEuroMinCutoff = value;
+            } else if (key == "oneEuroBeta") {
+                outSettings.smoothing.oneEuroBeta = value;
+            } else if (key == "oneEuroDerivativeCutoff") {
+                outSettings.smoothing.oneEuroDerivativeCutoff = value;
+            }
+        }
+    }
+    return true;
+}
+
+ClimbReplay::FrameResult ClimbReplay::Step(const Frame& frame)
+{
+    FrameResult result;
+    const FrameInput& input = frame.input;
+
+    // The first frame has no previous outcome - start from where it ended
+    if (!m_hasPlayerPos) {
+        m_playerPos = frame.outcome.playerPosition;
+        m_hasPlayerPos = true;
+    }
+
+    // Grip edges: which hands hold on after them is what the game decided (StartClimb / StopClimb)
+    bool wasClimbing = m_grabbing[0] || m_grabbing[1];
+    for (int hand = 0; hand < 2; ++hand) {
+        uint8_t flag = hand == 0 ? SessionStream::kLeftGrabbing : SessionStream::kRightGrabbing;
+        bool grabbing = (frame.outcome.state & flag) != 0;
+        if (grabbing && !m_grabbing[hand]) {
+            m_prevHandOffset[hand] = HandPosition(input, hand == 0, m_playerPos) - m_playerPos;
+            if (!m_hasTargetPosition) {
+                m_smoother.Reset();
+                m_targetPosition = m_playerPos;
+                m_hasTargetPosition = true;
+            }
+        }
+        m_grabbing[hand] = grabbing;
+    }
+
+    bool climbing = m_grabbing[0] || m_grabbing[1];
+    if (wasClimbing && !climbing) {
+        StopClimbing(result);
+    }
+
+    if (climbing) {
+        m_handsSampled = false;
+        if (m_settings.fixedStepRate > 0) {
+            // ClimbManager::UpdateClimbingFixedStep
+            if (!m_hasSimPosition) {
+                m_simPosition = m_playerPos;
+                m_prevSimPosition = m_playerPos;
+                m_hasSimPosition = true;
+                m_fixedStep.Reset();
+            } else {
+                Vec3 externalOffset = m_playerPos - m_displayedPosition;
+                m_simPosition = m_simPosition + externalOffset;
+                m_prevSimPosition = m_prevSimPosition + externalOffset;
+            }
+
+            int steps = m_fixedStep.Advance(input.deltaTime, m_settings.fixedStepRate, MAX_FIXED_STEPS_PER_FRAME);
+            for (int i = 0; i < steps; ++i) {
+                m_prevSimPosition = m_simPosition;
+                UpdateClimbing(input, m_fixedStep.GetStepTime());
+            }
+
+            float alpha = m_fixedStep.GetAlpha();
+            m_displayedPosition = m_prevSimPosition + (m_simPosition - m_prevSimPosition) * alpha;
+            m_position = m_displayedPosition;
+        } else {
+            m_position = m_playerPos;
+            UpdateClimbing(input, input.deltaTime);
+        }
+
+        result.climbing = true;
+        result.position = m_position;
+    } else {
+        m_fixedStep.Reset();
+        m_hasSimPosition = false;
+    }
+
+    // The next frame starts where the game actually put the player
+    m_playerPos = frame.outcome.playerPosition;
+    return result;
+}
+
+void ClimbReplay::UpdateClimbing(const FrameInput& input, float deltaTime)
+{
+    if (!std::isfinite(deltaTime) || deltaTime <= 0.0f) {
+        return;
+    }
+    deltaTime = (std::min)(deltaTime, MAX_DELTA);
+
+    // Hand nodes update once per rendered frame - only the first step of a frame pulls
+    m_unsampledTime += deltaTime;
+    if (!m_handsSampled) {
+        m_handsSampled = true;
+        Vec3 totalDelta = SampleHandMovement(input);
+        m_velocityHistory.Push(totalDelta, m_unsampledTime, m_settings.maxVelocitySamples, m_settings.velocityHistoryTime,
+            m_settings.velocityWeightExponent);
+        m_unsampledTime = 0.0f;
+        m_targetPosition = m_targetPosition + totalDelta;
+    }
+
+    Vec3 currentPos = m_hasSimPosition ? m_simPosition : m_position;
+    Vec3 newPos = m_smoother.Step(currentPos, m_targetPosition, deltaTime, m_settings.smoothing);
+    if (m_hasSimPosition) {
+        m_simPosition = newPos;
+    } else {
+        m_position = newPos;
+    }
+}
+
+Vec3 ClimbReplay::SampleHandMovement(const FrameInput& input)
+{
+    Vec3 totalDelta;
+    int grabCount = 0;
+    for (int hand = 0; hand < 2; ++hand) {
+        if (!m_grabbing[hand]) {
+            continue;
+        }
+
+        // The game reads the player's live position here, which is where the previous frame left it
+        Vec3 currentHandOffset = HandPosition(input, hand == 0, m_playerPos) - m_playerPos;
+        totalDelta = totalDelta - (currentHandOffset - m_prevHandOffset[hand]);  // Pull toward the grab point
+        m_prevHandOffset[hand] = currentHandOffset;
+        grabCount++;
+    }
+
+    if (grabCount > 1) {
+        totalDelta = totalDelta * (1.0f / static_cast<float>(grabCount));
+    }
+    return totalDelta;
+}
+
+void ClimbReplay::StopClimbing(FrameResult& result)
+{
+    // ClimbManager::CalculateLaunchVelocity's history estimate, before the equipment multiplier and speed cap
+    float filterAngle = m_settings.launchDirectionFilter;
+    bool filterEnabled = filterAngle > 0.0f && filterAngle < 180.0f;
+    constexpr float DEG_TO_RAD = 3.14159265f / 180.0f;
+    float cosThreshold = filterEnabled ? std::cos(filterAngle * DEG_TO_RAD) : -1.0f;
+
+    result.launched = true;
+    result.launchVelocity = m_velocityHistory.EstimateVelocity(cosThreshold).velocity;
+
+    m_velocityHistory.Clear();
+    m_hasTargetPosition = false;
+    m_smoother.Reset();
+    m_hasSimPosition = false;
+    m_unsampledTime = 0.0f;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "SessionStream.h"
+#include "ClimbSmoother.h"
+#include "FixedTimestep.h"
+#include "VelocityHistory.h"
+#include <string>
+
+// Re-runs a recorded session's climbing movement through the plugin's own math (ClimbSmoother,
+// VelocityHistory, FixedTimestep) and reports where it puts the player, frame by frame
+// Mirrors ClimbManager's per-frame and fixed-step paths: each grabbing hand's offset from the player pulls
+// the target position, the player is smoothed toward it, and releases estimate a launch from the history.
+// Which hands hold on comes from the recording - grabbing needs surface queries against the game world.
+// Not replayed: body sweeps (the target isn't clamped at walls), moving anchors, stamina, hand
+// prediction, physics-step and velocity climbing, and the controller velocity blended into launches.
+// Each frame starts from the player position the game recorded for the previous one, so a difference
+// shows one frame's divergence plus whatever the carried target position picked up.
+class ClimbReplay
+{
+public:
+    // The Config::options values the replayed climbing reads ([Climbing] and [ClimbingAbility])
+    struct Settings {
+        ClimbSmoother::Settings smoothing;
+        int fixedStepRate = 0;
+        int maxVelocitySamples = 10;
+        float velocityHistoryTime = 0.2f;
+        float velocityWeightExponent = 1.0f;
+        float launchDirectionFilter = 60.0f;
+    };
+
+    // Read the climbing values from a VRClimbing.ini - keys it doesn't have keep their defaults
+    // Returns false if the file can't be opened
+    static bool LoadSettings(const std::string& path, Settings& outSettings);
+
+    struct FrameResult {
+        bool climbing = false;           // A hand held on at the end of the frame
+        PhysicsQuery::Vec3 position;     // Recomputed player position (climbing frames only)
+        bool launched = false;           // The last hand let go this frame
+        PhysicsQuery::Vec3 launchVelocity;
+    };
+
+    explicit ClimbReplay(const Settings& settings) : m_settings(settings) {}
+
+    // Advance by one recorded frame
+    FrameResult Step(const SessionStream::Frame& frame);
+
+private:
+    // One climbing update (ClimbManager::UpdateClimbing) - the hands pull on the first step of each frame
+    void UpdateClimbing(const SessionStream::FrameInput& input, float deltaTime);
+
+    // Movement of the player from the grabbing hands (averaged over them), updating their offsets
+    PhysicsQuery::Vec3 SampleHandMovement(const SessionStream::FrameInput& input);
+
+    void StopClimbing(FrameResult& result);
+
+    Settings m_settings;
+
+    bool m_grabbing[2] = {};                // Left=0, Right=1, as recorded
+    PhysicsQuery::Vec3 m_prevHandOffset[2];  // Hand offset from the player at the last sample
+
+    PhysicsQuery::Vec3 m_playerPos;          // Player position at the top of the frame (recorded)
+    bool m_hasPlayerPos = false;
+
+    PhysicsQuery::Vec3 m_targetPosition;
+    bool m_hasTargetPosition = false;
+    ClimbSmoother m_smoother;
+    VelocityHistory m_velocityHistory;
+
+    // Fixed-step climbing (fixedStepRate > 0)
+    static constexpr int MAX_FIXED_STEPS_PER_FRAME = 5;
+    FixedTimestep m_fixedStep;
+    PhysicsQuery::Vec3 m_simPosition;
+    PhysicsQuery::Vec3 m_prevSimPosition;
+    PhysicsQuery::Vec3 m_displayedPosition;
+    bool m_hasSimPosition = false;
+
+    PhysicsQuery::Vec3 m_position;           // Player position as the climbing update left it
+    bool m_handsSampled = false;             // The hands already pulled this frame
+    float m_unsampledTime = 0.0f;            // Step time since the last hand sample
+};
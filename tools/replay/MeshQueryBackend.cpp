@@ -0,0 +1,334 @@
+#include "MeshQueryBackend.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+using PhysicsQuery::LayerMask;
+using PhysicsQuery::OutputFlags;
+using PhysicsQuery::QueryHit;
+using PhysicsQuery::RayQuery;
+using PhysicsQuery::Vec3;
+
+// Triangles per BVH leaf
+static constexpr uint32_t MAX_LEAF_TRIANGLES = 4;
+
+// Traversal stack depth - a median-split tree over 4-triangle leaves stays far below this
+static constexpr size_t MAX_TRAVERSAL_DEPTH = 64;
+
+static Vec3 Min(const Vec3& a, const Vec3& b) {
+    return { (std::min)(a.x, b.x), (std::min)(a.y, b.y), (std::min)(a.z, b.z) };
+}
+
+static Vec3 Max(const Vec3& a, const Vec3& b) {
+    return { (std::max)(a.x, b.x), (std::max)(a.y, b.y), (std::max)(a.z, b.z) };
+}
+
+static float Axis(const Vec3& v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+static LayerMask LayerBit(uint32_t layer) {
+    return 1ULL << layer;
+}
+
+// Ray vs box slab test - returns false if the ray misses or enters beyond maxT
+static bool RayHitsBounds(const Vec3& origin, const Vec3& invDirection, const Vec3& boundsMin, const Vec3& boundsMax, float maxT) {
+    float tMin = 0.0f;
+    float tMax = maxT;
+    for (int axis = 0; axis < 3; ++axis) {
+        float o = Axis(origin, axis);
+        float inv = Axis(invDirection, axis);
+        float t0 = (Axis(boundsMin, axis) - o) * inv;
+        float t1 = (Axis(boundsMax, axis) - o) * inv;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tMin = (std::max)(tMin, t0);
+        tMax = (std::min)(tMax, t1);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshQueryBackend::AddTriangle(const Vec3& v0, const Vec3& v1, const Vec3& v2, uint32_t layer, void* userData)
+{
+    Vec3 normal = PhysicsQuery::Cross(v1 - v0, v2 - v0);
+    float length = PhysicsQuery::Length(normal);
+    if (length <= 0.0f || layer >= 64) {
+        return;  // Degenerate triangle, or a layer that can't be expressed in a mask
+    }
+
+    m_triangles.push_back(Triangle{ v0, v1, v2, normal * (1.0f / length), layer, userData });
+    m_built = false;
+}
+
+void MeshQueryBackend::AddMesh(std::span<const Vec3> vertices, std::span<const uint32_t> indices, uint32_t layer, void* userData)
+{
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        uint32_t i0 = indices[i];
+        uint32_t i1 = indices[i + 1];
+        uint32_t i2 = indices[i + 2];
+        if (i0 >= vertices.size() || i1 >= vertices.size() || i2 >= vertices.size()) {
+            continue;
+        }
+        AddTriangle(vertices[i0], vertices[i1], vertices[i2], layer, userData);
+    }
+}
+
+void MeshQueryBackend::AddQuad(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d, uint32_t layer, void* userData)
+{
+    AddTriangle(a, b, c, layer, userData);
+    AddTriangle(a, c, d, layer, userData);
+}
+
+void MeshQueryBackend::AddBox(const Vec3& min, const Vec3& max, uint32_t layer, void* userData)
+{
+    const Vec3 corners[8] = {
+        { min.x, min.y, min.z }, { max.x, min.y, min.z }, { max.x, max.y, min.z }, { min.x, max.y, min.z },
+        { min.x, min.y, max.z }, { max.x, min.y, max.z }, { max.x, max.y, max.z }, { min.x, max.y, max.z },
+    };
+
+    // Outward-facing quads: bottom, top, -Y, +X, +Y, -X
+    AddQuad(corners[0], corners[3], corners[2], corners[1], layer, userData);
+    AddQuad(corners[4], corners[5], corners[6], corners[7], layer, userData);
+    AddQuad(corners[0], corners[1], corners[5], corners[4], layer, userData);
+    AddQuad(corners[1], corners[2], corners[6], corners[5], layer, userData);
+    AddQuad(corners[2], corners[3], corners[7], corners[6], layer, userData);
+    AddQuad(corners[3], corners[0], corners[4], corners[7], layer, userData);
+}
+
+void MeshQueryBackend::AddHeightfield(const Vec3& origin, float cellSize, uint32_t countX, uint32_t countY,
+    std::span<const float> heights, uint32_t layer, void* userData)
+{
+    if (countX < 2 || countY < 2 || heights.size() < static_cast<size_t>(countX) * countY) {
+        return;
+    }
+
+    auto vertex = [&](uint32_t x, uint32_t y) {
+        return Vec3{ origin.x + x * cellSize, origin.y + y * cellSize, origin.z + heights[static_cast<size_t>(y) * countX + x] };
+    };
+
+    for (uint32_t y = 0; y + 1 < countY; ++y) {
+        for (uint32_t x = 0; x + 1 < countX; ++x) {
+            AddQuad(vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1), vertex(x, y + 1), layer, userData);
+        }
+    }
+}
+
+bool MeshQueryBackend::LoadObj(const std::string& path, uint32_t layer, void* userData)
+{
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    std::vector<Vec3> vertices;
+    size_t trianglesBefore = m_triangles.size();
+
+    std::string line;
+    std::vector<uint32_t> face;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string tag;
+        stream >> tag;
+
+        if (tag == "v") {
+            Vec3 v;
+            stream >> v.x >> v.y >> v.z;
+            vertices.push_back(v);
+        } else if (tag == "f") {
+            // Each entry is "v", "v/vt", "v//vn" or "v/vt/vn" - only the position index matters
+            // Negative indices count back from the most recent vertex
+            face.clear();
+            std::string entry;
+            while (stream >> entry) {
+                long index = std::strtol(entry.c_str(), nullptr, 10);
+                if (index < 0) {
+                    index += static_cast<long>(vertices.size()) + 1;
+                }
+                if (index < 1 || static_cast<size_t>(index) > vertices.size()) {
+                    face.clear();
+                    break;
+                }
+                face.push_back(static_cast<uint32_t>(index - 1));
+            }
+
+            for (size_t i = 1; i + 1 < face.size(); ++i) {
+                AddTriangle(vertices[face[0]], vertices[face[i]], vertices[face[i + 1]], layer, userData);
+            }
+        }
+    }
+
+    return m_triangles.size() > trianglesBefore;
+}
+
+void MeshQueryBackend::Clear()
+{
+    m_triangles.clear();
+    m_nodes.clear();
+    m_built = false;
+}
+
+void MeshQueryBackend::Build()
+{
+    m_nodes.clear();
+    m_built = true;
+
+    if (m_triangles.empty()) {
+        return;
+    }
+
+    // A binary tree with n leaves has 2n - 1 nodes
+    m_nodes.reserve(2 * (m_triangles.size() / MAX_LEAF_TRIANGLES + 1));
+    BuildNode(0, static_cast<uint32_t>(m_triangles.size()));
+}
+
+uint32_t MeshQueryBackend::BuildNode(uint32_t first, uint32_t count)
+{
+    uint32_t index = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    Bounds bounds{ m_triangles[first].v0, m_triangles[first].v0 };
+    Bounds centroidBounds{ bounds };
+    LayerMask layers = 0;
+    for (uint32_t i = first; i < first + count; ++i) {
+        const Triangle& tri = m_triangles[i];
+        bounds.min = Min(Min(bounds.min, tri.v0), Min(tri.v1, tri.v2));
+        bounds.max = Max(Max(bounds.max, tri.v0), Max(tri.v1, tri.v2));
+
+        Vec3 centroid = (tri.v0 + tri.v1 + tri.v2) * (1.0f / 3.0f);
+        if (i == first) {
+            centroidBounds = { centroid, centroid };
+        }
+        centroidBounds.min = Min(centroidBounds.min, centroid);
+        centroidBounds.max = Max(centroidBounds.max, centroid);
+
+        layers |= LayerBit(tri.layer);
+    }
+
+    m_nodes[index].bounds = bounds;
+    m_nodes[index].layers = layers;
+
+    if (count <= MAX_LEAF_TRIANGLES) {
+        m_nodes[index].first = first;
+        m_nodes[index].count = count;
+        return index;
+    }
+
+    // Median split along the widest axis of the triangle centroids
+    Vec3 extent = centroidBounds.max - centroidBounds.min;
+    int axis = 0;
+    if (extent.y > extent.x) {
+        axis = 1;
+    }
+    if (extent.z > Axis(extent, axis)) {
+        axis = 2;
+    }
+
+    uint32_t half = count / 2;
+    auto begin = m_triangles.begin() + first;
+    std::nth_element(begin, begin + half, begin + count, [axis](const Triangle& a, const Triangle& b) {
+        return Axis(a.v0 + a.v1 + a.v2, axis) < Axis(b.v0 + b.v1 + b.v2, axis);
+    });
+
+    BuildNode(first, half);
+    uint32_t right = BuildNode(first + half, count - half);
+    m_nodes[index].rightChild = right;
+    return index;
+}
+
+QueryHit MeshQueryBackend::CastRay(const RayQuery& query)
+{
+    QueryHit result;
+    result.distance = query.maxDistance;
+    result.point = query.origin + query.direction * query.maxDistance;
+
+    if (!m_built) {
+        Build();
+    }
+    if (m_nodes.empty() || query.maxDistance <= 0.0f) {
+        return result;
+    }
+
+    constexpr float HUGE_INVERSE = std::numeric_limits<float>::max();
+    Vec3 invDirection{
+        query.direction.x != 0.0f ? 1.0f / query.direction.x : HUGE_INVERSE,
+        query.direction.y != 0.0f ? 1.0f / query.direction.y : HUGE_INVERSE,
+        query.direction.z != 0.0f ? 1.0f / query.direction.z : HUGE_INVERSE
+    };
+
+    const Triangle* best = nullptr;
+    float bestT = query.maxDistance;
+
+    uint32_t stack[MAX_TRAVERSAL_DEPTH];
+    size_t stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if ((node.layers & query.layerMask) == 0 ||
+            !RayHitsBounds(query.origin, invDirection, node.bounds.min, node.bounds.max, bestT)) {
+            continue;
+        }
+
+        if (node.count == 0) {
+            uint32_t left = static_cast<uint32_t>(&node - m_nodes.data()) + 1;
+            if (stackSize + 2 <= MAX_TRAVERSAL_DEPTH) {
+                stack[stackSize++] = node.rightChild;
+                stack[stackSize++] = left;
+            }
+            continue;
+        }
+
+        // Moller-Trumbore, two-sided
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const Triangle& tri = m_triangles[i];
+            if ((LayerBit(tri.layer) & query.layerMask) == 0) {
+                continue;
+            }
+
+            Vec3 e1 = tri.v1 - tri.v0;
+            Vec3 e2 = tri.v2 - tri.v0;
+            Vec3 p = PhysicsQuery::Cross(query.direction, e2);
+            float det = PhysicsQuery::Dot(e1, p);
+            if (std::fabs(det) < 1e-8f) {
+                continue;  // Ray parallel to the triangle
+            }
+
+            float invDet = 1.0f / det;
+            Vec3 s = query.origin - tri.v0;
+            float u = PhysicsQuery::Dot(s, p) * invDet;
+            if (u < 0.0f || u > 1.0f) {
+                continue;
+            }
+
+            Vec3 q = PhysicsQuery::Cross(s, e1);
+            float v = PhysicsQuery::Dot(query.direction, q) * invDet;
+            if (v < 0.0f || u + v > 1.0f) {
+                continue;
+            }
+
+            float t = PhysicsQuery::Dot(e2, q) * invDet;
+            if (t >= 0.0f && t < bestT) {
+                bestT = t;
+                best = &tri;
+            }
+        }
+    }
+
+    if (!best) {
+        return result;
+    }
+
+    result.hit = true;
+    result.distance = bestT;
+    result.point = query.origin + query.direction * bestT;
+    result.normal = PhysicsQuery::Dot(best->normal, query.direction) > 0.0f ? best->normal * -1.0f : best->normal;
+    result.layer = best->layer;
+    result.userData = best->userData;
+    return result;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "QueryBackend.h"
+#include <string>
+#include <vector>
+
+// Stand-in query backend over static triangle meshes (walls, ledges, terrain patches)
+// Part of tools/replay, not the plugin: the replayer re-resolves recorded queries against it. No
+// CommonLib/Windows dependencies, builds with MSVC, GCC and Clang.
+// Add geometry, call Build(), then query. Geometry added after Build() is not visible until the next Build().
+// Triangles are two-sided; hit normals face the ray origin.
+// Every hit field comes for free here, so output flags are ignored.
+class MeshQueryBackend : public PhysicsQuery::QueryBackend
+{
+public:
+    // Indexed triangle mesh on one collision layer (3 indices per triangle)
+    // userData is reported back on hits (e.g. an id for the mesh)
+    void AddMesh(std::span<const PhysicsQuery::Vec3> vertices, std::span<const uint32_t> indices,
+        uint32_t layer, void* userData = nullptr);
+
+    // Quad from 4 corners in winding order (walls) - 2 triangles
+    void AddQuad(const PhysicsQuery::Vec3& a, const PhysicsQuery::Vec3& b, const PhysicsQuery::Vec3& c, const PhysicsQuery::Vec3& d,
+        uint32_t layer, void* userData = nullptr);
+
+    // Axis-aligned box from min/max corners (ledges, blocks) - 12 triangles
+    void AddBox(const PhysicsQuery::Vec3& min, const PhysicsQuery::Vec3& max, uint32_t layer, void* userData = nullptr);
+
+    // Terrain patch: countX * countY grid of heights (row-major, X fastest) spaced cellSize apart from origin
+    void AddHeightfield(const PhysicsQuery::Vec3& origin, float cellSize, uint32_t countX, uint32_t countY,
+        std::span<const float> heights, uint32_t layer, void* userData = nullptr);
+
+    // Load "v" and "f" records from a Wavefront OBJ file onto one layer (polygons are fanned into triangles)
+    // Returns false if the file can't be opened or has no usable faces
+    bool LoadObj(const std::string& path, uint32_t layer, void* userData = nullptr);
+
+    // (Re)build the bounding volume hierarchy over every triangle added so far
+    void Build();
+
+    // Remove all geometry
+    void Clear();
+
+    size_t GetTriangleCount() const { return m_triangles.size(); }
+
+    // CastMultiDirectionalRays and SweepCapsule keep the default rays, so they answer exactly what the Havok
+    // backend's picks would against the same geometry
+    PhysicsQuery::QueryHit CastRay(const PhysicsQuery::RayQuery& query) override;
+
+private:
+    struct Triangle {
+        PhysicsQuery::Vec3 v0, v1, v2;
+        PhysicsQuery::Vec3 normal;  // Unit face normal (v1 - v0) x (v2 - v0)
+        uint32_t layer = 0;
+        void* userData = nullptr;
+    };
+
+    struct Bounds {
+        PhysicsQuery::Vec3 min;
+        PhysicsQuery::Vec3 max;
+    };
+
+    // Flat BVH node - the left child of an inner node is the next node, the right child is rightChild
+    struct Node {
+        Bounds bounds;
+        PhysicsQuery::LayerMask layers = 0;  // Union of the layers below this node, for masked queries
+        uint32_t first = 0;                  // Leaf: first triangle in m_triangles
+        uint32_t count = 0;                  // Leaf: triangle count (0 = inner node)
+        uint32_t rightChild = 0;             // Inner: index of the right child
+    };
+
+    void AddTriangle(const PhysicsQuery::Vec3& v0, const PhysicsQuery::Vec3& v1, const PhysicsQuery::Vec3& v2,
+        uint32_t layer, void* userData);
+    uint32_t BuildNode(uint32_t first, uint32_t count);
+
+    std::vector<Triangle> m_triangles;
+    std::vector<Node> m_nodes;
+    bool m_built = false;
+};
@@ -0,0 +1,116 @@
+// MeshQueryBackend checks - rays, the 6 cardinal rays and capsule sweeps against known geometry
+// Run with ctest from the replay build (see CMakeLists.txt). Prints every failed check; exit code is the count.
+
+#include "MeshQueryBackend.h"
+#include <cmath>
+#include <cstdio>
+
+using PhysicsQuery::CapsuleSweep;
+using PhysicsQuery::LayerMask;
+using PhysicsQuery::QueryHit;
+using PhysicsQuery::RayQuery;
+using PhysicsQuery::Vec3;
+
+static constexpr uint32_t WALL_LAYER = 1;
+static constexpr uint32_t CLUTTER_LAYER = 4;
+static constexpr LayerMask WALL_MASK = 1ULL << WALL_LAYER;
+static constexpr LayerMask ALL_LAYERS = ~0ULL;
+static constexpr float TOLERANCE = 1e-3f;
+
+static int s_failures = 0;
+
+static void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::printf("FAILED: %s\n", what);
+        s_failures++;
+    }
+}
+
+static bool Near(float a, float b) {
+    return std::abs(a - b) <= TOLERANCE;
+}
+
+static bool Near(const Vec3& a, const Vec3& b) {
+    return Near(a.x, b.x) && Near(a.y, b.y) && Near(a.z, b.z);
+}
+
+// Wall box filling x = 50..60 (layer WALL_LAYER) and a clutter box above it at x = 20..30 (layer CLUTTER_LAYER)
+static void BuildScene(MeshQueryBackend& scene) {
+    scene.AddBox({ 50.0f, -100.0f, -100.0f }, { 60.0f, 100.0f, 200.0f }, WALL_LAYER);
+    scene.AddBox({ 20.0f, -10.0f, 300.0f }, { 30.0f, 10.0f, 320.0f }, CLUTTER_LAYER);
+    scene.Build();
+}
+
+static void TestRays(MeshQueryBackend& scene) {
+    QueryHit hit = scene.CastRay(RayQuery{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, 100.0f, ALL_LAYERS });
+    Check(hit.hit, "ray toward the wall hits");
+    Check(Near(hit.distance, 50.0f), "ray hit distance is the gap to the wall");
+    Check(Near(hit.point, { 50.0f, 0.0f, 0.0f }), "ray hit point is on the wall face");
+    Check(Near(hit.normal, { -1.0f, 0.0f, 0.0f }), "ray hit normal faces the ray origin");
+    Check(hit.layer == WALL_LAYER, "ray hit reports the wall's layer");
+
+    hit = scene.CastRay(RayQuery{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, 40.0f, ALL_LAYERS });
+    Check(!hit.hit, "ray shorter than the gap misses");
+    Check(Near(hit.distance, 40.0f), "missed ray reports its full length");
+
+    hit = scene.CastRay(RayQuery{ { 0.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, 100.0f, ALL_LAYERS });
+    Check(!hit.hit, "ray away from the wall misses");
+
+    hit = scene.CastRay(RayQuery{ { 25.0f, 0.0f, 250.0f }, { 0.0f, 0.0f, 1.0f }, 100.0f, WALL_MASK });
+    Check(!hit.hit, "ray ignores layers outside its mask");
+    hit = scene.CastRay(RayQuery{ { 25.0f, 0.0f, 250.0f }, { 0.0f, 0.0f, 1.0f }, 100.0f, ALL_LAYERS });
+    Check(hit.hit && hit.layer == CLUTTER_LAYER && Near(hit.distance, 50.0f), "ray hits layers inside its mask");
+}
+
+static void TestMultiDirectionalRays(MeshQueryBackend& scene) {
+    QueryHit hit = scene.CastMultiDirectionalRays({ 40.0f, 0.0f, 0.0f }, 20.0f, ALL_LAYERS, PhysicsQuery::kAllOutputs);
+    Check(hit.hit, "6 rays next to the wall hit");
+    Check(Near(hit.distance, 10.0f), "6-ray hit is the nearest axis contact");
+    Check(Near(hit.normal, { -1.0f, 0.0f, 0.0f }), "6-ray hit normal faces the origin");
+
+    hit = scene.CastMultiDirectionalRays({ 40.0f, 0.0f, 0.0f }, 5.0f, ALL_LAYERS, PhysicsQuery::kAllOutputs);
+    Check(!hit.hit, "6 rays shorter than the gap miss");
+    Check(Near(hit.distance, 5.0f) && Near(hit.point, { 40.0f, 0.0f, 0.0f }), "6-ray miss reports the origin and length");
+
+    // The wall corner is 10 * sqrt(2) away diagonally, between the axes - the rays pass either side of it
+    hit = scene.CastMultiDirectionalRays({ 40.0f, 0.0f, 210.0f }, 15.0f, ALL_LAYERS, PhysicsQuery::kAllOutputs);
+    Check(!hit.hit, "6 rays miss a surface that lies between the axes");
+}
+
+static void TestCapsuleSweeps(MeshQueryBackend& scene) {
+    CapsuleSweep sweep;
+    sweep.segmentStart = { 0.0f, 0.0f, 16.0f };
+    sweep.segmentEnd = { 0.0f, 0.0f, 100.0f };
+    sweep.radius = 16.0f;
+    sweep.direction = { 1.0f, 0.0f, 0.0f };
+    sweep.maxDistance = 100.0f;
+    sweep.layerMask = ALL_LAYERS;
+
+    QueryHit hit = scene.SweepCapsule(sweep);
+    Check(hit.hit, "capsule swept into the wall hits");
+    Check(Near(hit.distance, 34.0f), "capsule stops one radius short of the wall");
+
+    sweep.maxDistance = 10.0f;
+    hit = scene.SweepCapsule(sweep);
+    Check(!hit.hit && Near(hit.distance, 10.0f), "capsule short of the wall travels the whole way");
+
+    sweep.direction = { -1.0f, 0.0f, 0.0f };
+    sweep.maxDistance = 100.0f;
+    hit = scene.SweepCapsule(sweep);
+    Check(!hit.hit, "capsule swept away from the wall is clear");
+}
+
+int main() {
+    MeshQueryBackend scene;
+    BuildScene(scene);
+    Check(scene.GetTriangleCount() == 24, "two boxes are 24 triangles");
+
+    TestRays(scene);
+    TestMultiDirectionalRays(scene);
+    TestCapsuleSweeps(scene);
+
+    if (s_failures == 0) {
+        std::printf("All mesh backend checks passed\n");
+    }
+    return s_failures;
+}
@@ -0,0 +1,374 @@
+// VRClimbingReplay - offline query differ and profiler for a recorded climbing session (see src/util/SessionStream.h)
+//
+// Reads the stream frame by frame and reports:
+// - the recorded per-frame update time (mean, percentiles, worst frames)
+// - the query workload (count per frame by kind, hit rate)
+// - the recorded hand movement re-run through the plugin's climbing math (see ClimbReplay.h), with the
+//   player position it arrives at diffed against the recorded one; --ini takes the smoothing, fixed-step
+//   and launch values from the VRClimbing.ini the session was recorded with (shipped defaults otherwise)
+// - with --scene, every recorded query re-resolved against a mesh of the level, timed, and diffed
+//   against the answer the game gave (hit/miss flips and hit point distance)
+// - with --baseline, player position and climb state diffed frame by frame against another recording
+// --csv writes one row per frame.
+
+#include "SessionStream.h"
+#include "MeshQueryBackend.h"
+#include "ClimbReplay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using PhysicsQuery::QueryHit;
+using PhysicsQuery::Vec3;
+using SessionStream::Frame;
+using SessionStream::QueryKind;
+using SessionStream::QueryRecord;
+
+using Clock = std::chrono::steady_clock;
+
+// Scene geometry goes on COL_LAYER::kStatic, which every climbing layer mask accepts
+static constexpr uint32_t SCENE_LAYER = 1;
+
+// Hit points closer than this (game units) count as the same answer
+static constexpr float HIT_POINT_TOLERANCE = 1.0f;
+
+// Player positions closer than this count as the same
+static constexpr float POSITION_TOLERANCE = 0.5f;
+
+static constexpr size_t WORST_FRAME_COUNT = 5;
+
+struct Options {
+    std::string sessionPath;
+    std::string scenePath;
+    std::string baselinePath;
+    std::string csvPath;
+    std::string iniPath;
+};
+
+struct FrameReport {
+    uint32_t frameNumber = 0;
+    float deltaTime = 0.0f;
+    float updateMicros = 0.0f;
+    uint32_t queries = 0;
+    float replayMicros = 0.0f;     // Scene re-resolve time
+    uint32_t answerDiffs = 0;      // Queries whose scene answer differs from the recorded one
+    float maxHitDiff = 0.0f;       // Largest hit point distance among matching hits
+    float positionDiff = 0.0f;     // Distance to the baseline's player position
+    bool stateDiff = false;        // Climb/flight state differs from the baseline
+    bool climbing = false;         // A hand held on at the end of the frame
+    float climbDiff = 0.0f;        // Distance from the replayed climbing position to the recorded one
+    uint8_t state = 0;
+};
+
+static float Distance(const Vec3& a, const Vec3& b) {
+    return PhysicsQuery::Length(a - b);
+}
+
+static void PrintUsage() {
+    std::printf(
+        "Usage: VRClimbingReplay <session.vcr> [--scene <mesh.obj>] [--baseline <other.vcr>] [--csv <frames.csv>]\n"
+        "                        [--ini <VRClimbing.ini>]\n"
+        "  --scene     Re-resolve every recorded query against this mesh and diff the answers\n"
+        "  --baseline  Diff player position and climb state against another recording, frame by frame\n"
+        "  --csv       Write one row per frame\n"
+        "  --ini       Climbing settings the session was recorded with, for the climbing replay\n");
+}
+
+static bool ParseOptions(int argc, char** argv, Options& outOptions) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--scene") == 0 && hasValue) {
+            outOptions.scenePath = argv[++i];
+        } else if (std::strcmp(arg, "--baseline") == 0 && hasValue) {
+            outOptions.baselinePath = argv[++i];
+        } else if (std::strcmp(arg, "--csv") == 0 && hasValue) {
+            outOptions.csvPath = argv[++i];
+        } else if (std::strcmp(arg, "--ini") == 0 && hasValue) {
+            outOptions.iniPath = argv[++i];
+        } else if (arg[0] != '-' && outOptions.sessionPath.empty()) {
+            outOptions.sessionPath = arg;
+        } else {
+            return false;
+        }
+    }
+    return !outOptions.sessionPath.empty();
+}
+
+// Resolve a recorded query against the scene
+static QueryHit Resolve(MeshQueryBackend& scene, const QueryRecord& query) {
+    switch (query.kind) {
+    case QueryKind::kMultiDirectional:
+        return scene.CastMultiDirectionalRays(query.ray.origin, query.ray.maxDistance, query.ray.layerMask, query.ray.outputs);
+    case QueryKind::kCapsule:
+        return scene.SweepCapsule(query.capsule);
+    default:
+        return scene.CastRay(query.ray);
+    }
+}
+
+// Re-resolve the frame's queries against the scene and compare with the recorded answers
+static void ReplayQueries(MeshQueryBackend& scene, const Frame& frame, FrameReport& report) {
+    auto start = Clock::now();
+    std::vector<QueryHit> hits;
+    hits.reserve(frame.queries.size());
+    for (const auto& query : frame.queries) {
+        hits.push_back(Resolve(scene, query));
+    }
+    report.replayMicros = std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+
+    for (size_t i = 0; i < hits.size(); ++i) {
+        const QueryHit& recorded = frame.queries[i].hit;
+        if (hits[i].hit != recorded.hit) {
+            report.answerDiffs++;
+            continue;
+        }
+        if (!recorded.hit) {
+            continue;
+        }
+        float diff = Distance(hits[i].point, recorded.point);
+        report.maxHitDiff = (std::max)(report.maxHitDiff, diff);
+        if (diff > HIT_POINT_TOLERANCE) {
+            report.answerDiffs++;
+        }
+    }
+}
+
+static float Percentile(std::vector<float> values, float fraction) {
+    if (values.empty()) {
+        return 0.0f;
+    }
+    size_t index = static_cast<size_t>(fraction * static_cast<float>(values.size() - 1) + 0.5f);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static void WriteCsv(const std::string& path, const std::vector<FrameReport>& reports) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::fprintf(stderr, "Could not write %s\n", path.c_str());
+        return;
+    }
+
+    std::fprintf(file, "frame,dt,updateMicros,queries,replayMicros,answerDiffs,maxHitDiff,positionDiff,stateDiff,state,climbDiff\n");
+    for (const auto& r : reports) {
+        std::fprintf(file, "%u,%.6f,%.1f,%u,%.1f,%u,%.3f,%.3f,%d,%u,%.3f\n",
+            r.frameNumber, r.deltaTime, r.updateMicros, r.queries, r.replayMicros,
+            r.answerDiffs, r.maxHitDiff, r.positionDiff, r.stateDiff ? 1 : 0, r.state, r.climbDiff);
+    }
+    std::fclose(file);
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    SessionStream::Reader session;
+    if (!session.Open(options.sessionPath)) {
+        std::fprintf(stderr, "Could not open session %s (missing file or not a v%u stream)\n",
+            options.sessionPath.c_str(), SessionStream::kVersion);
+        return 1;
+    }
+
+    MeshQueryBackend scene;
+    bool hasScene = !options.scenePath.empty();
+    if (hasScene) {
+        if (!scene.LoadObj(options.scenePath, SCENE_LAYER)) {
+            std::fprintf(stderr, "Could not load scene %s\n", options.scenePath.c_str());
+            return 1;
+        }
+        scene.Build();
+    }
+
+    ClimbReplay::Settings climbSettings;
+    if (!options.iniPath.empty() && !ClimbReplay::LoadSettings(options.iniPath, climbSettings)) {
+        std::fprintf(stderr, "Could not read settings %s\n", options.iniPath.c_str());
+        return 1;
+    }
+    ClimbReplay climbReplay(climbSettings);
+
+    SessionStream::Reader baseline;
+    bool hasBaseline = !options.baselinePath.empty();
+    if (hasBaseline && !baseline.Open(options.baselinePath)) {
+        std::fprintf(stderr, "Could not open baseline %s\n", options.baselinePath.c_str());
+        return 1;
+    }
+
+    std::vector<FrameReport> reports;
+    uint64_t queryCounts[3] = {};
+    uint64_t queryHits = 0;
+    uint32_t maxQueriesPerFrame = 0;
+    uint32_t gripPresses = 0;
+    uint32_t flights = 0;
+    bool baselineEnded = !hasBaseline;
+    int64_t firstDivergentFrame = -1;
+    uint32_t launches = 0;
+    double launchSpeedTotal = 0.0;
+    double sessionSeconds = 0.0;
+
+    auto replayStart = Clock::now();
+
+    Frame frame;
+    Frame baselineFrame;
+    uint8_t previousState = 0;
+    while (session.Next(frame)) {
+        FrameReport report;
+        report.frameNumber = frame.input.frameNumber;
+        report.deltaTime = frame.input.deltaTime;
+        report.updateMicros = frame.outcome.updateMicros;
+        report.queries = static_cast<uint32_t>(frame.queries.size());
+        report.state = frame.outcome.state;
+        sessionSeconds += frame.input.deltaTime;
+
+        for (const auto& query : frame.queries) {
+            queryCounts[static_cast<size_t>(query.kind)]++;
+            queryHits += query.hit.hit ? 1 : 0;
+        }
+        maxQueriesPerFrame = (std::max)(maxQueriesPerFrame, report.queries);
+
+        for (uint8_t bit : { SessionStream::kLeftGrip, SessionStream::kRightGrip }) {
+            gripPresses += (frame.input.gripPressed & bit) ? 1 : 0;
+        }
+        if ((frame.outcome.state & SessionStream::kInFlight) && !(previousState & SessionStream::kInFlight)) {
+            flights++;
+        }
+        previousState = frame.outcome.state;
+
+        if (hasScene) {
+            ReplayQueries(scene, frame, report);
+        }
+
+        ClimbReplay::FrameResult climb = climbReplay.Step(frame);
+        if (climb.climbing) {
+            report.climbing = true;
+            report.climbDiff = Distance(climb.position, frame.outcome.playerPosition);
+        }
+        if (climb.launched) {
+            launches++;
+            launchSpeedTotal += PhysicsQuery::Length(climb.launchVelocity);
+        }
+
+        if (!baselineEnded) {
+            if (baseline.Next(baselineFrame)) {
+                report.positionDiff = Distance(frame.outcome.playerPosition, baselineFrame.outcome.playerPosition);
+                report.stateDiff = frame.outcome.state != baselineFrame.outcome.state;
+                if (firstDivergentFrame < 0 && (report.positionDiff > POSITION_TOLERANCE || report.stateDiff)) {
+                    firstDivergentFrame = static_cast<int64_t>(reports.size());
+                }
+            } else {
+                baselineEnded = true;
+            }
+        }
+
+        reports.push_back(report);
+    }
+
+    double replaySeconds = std::chrono::duration<double>(Clock::now() - replayStart).count();
+
+    if (session.HasError()) {
+        std::fprintf(stderr, "Warning: session stream ends in a damaged or truncated frame - stopped after %zu frames\n",
+            reports.size());
+    }
+
+    if (reports.empty()) {
+        std::fprintf(stderr, "No frames in %s\n", options.sessionPath.c_str());
+        return 1;
+    }
+
+    // ===== Summary =====
+    std::vector<float> updateTimes;
+    updateTimes.reserve(reports.size());
+    double updateTotal = 0.0;
+    for (const auto& r : reports) {
+        updateTimes.push_back(r.updateMicros);
+        updateTotal += r.updateMicros;
+    }
+
+    uint64_t totalQueries = queryCounts[0] + queryCounts[1] + queryCounts[2];
+    std::printf("Session: %s\n", options.sessionPath.c_str());
+    std::printf("  %zu frames, %.1f s recorded, replayed in %.3f s (%.0fx)\n",
+        reports.size(), sessionSeconds, replaySeconds, replaySeconds > 0.0 ? sessionSeconds / replaySeconds : 0.0);
+    std::printf("  grip presses %u, flights %u\n", gripPresses, flights);
+
+    std::printf("Update time (us): mean %.1f, p50 %.1f, p99 %.1f, max %.1f\n",
+        updateTotal / static_cast<double>(reports.size()), Percentile(updateTimes, 0.5f), Percentile(updateTimes, 0.99f),
+        *std::max_element(updateTimes.begin(), updateTimes.end()));
+
+    std::vector<const FrameReport*> worst;
+    for (const auto& r : reports) {
+        worst.push_back(&r);
+    }
+    size_t worstCount = (std::min)(WORST_FRAME_COUNT, worst.size());
+    std::partial_sort(worst.begin(), worst.begin() + worstCount, worst.end(),
+        [](const FrameReport* a, const FrameReport* b) { return a->updateMicros > b->updateMicros; });
+    for (size_t i = 0; i < worstCount; ++i) {
+        std::printf("  frame %u: %.1f us, %u queries\n", worst[i]->frameNumber, worst[i]->updateMicros, worst[i]->queries);
+    }
+
+    std::printf("Queries: %llu (rays %llu, 6-ray probes %llu, capsules %llu), %.1f per frame, max %u, hit rate %.1f%%\n",
+        static_cast<unsigned long long>(totalQueries), static_cast<unsigned long long>(queryCounts[0]),
+        static_cast<unsigned long long>(queryCounts[1]), static_cast<unsigned long long>(queryCounts[2]),
+        static_cast<double>(totalQueries) / static_cast<double>(reports.size()), maxQueriesPerFrame,
+        totalQueries > 0 ? 100.0 * static_cast<double>(queryHits) / static_cast<double>(totalQueries) : 0.0);
+
+    if (hasScene) {
+        double replayQueryMicros = 0.0;
+        uint64_t answerDiffs = 0;
+        float maxHitDiff = 0.0f;
+        for (const auto& r : reports) {
+            replayQueryMicros += r.replayMicros;
+            answerDiffs += r.answerDiffs;
+            maxHitDiff = (std::max)(maxHitDiff, r.maxHitDiff);
+        }
+        std::printf("Scene %s (%zu triangles): queries resolved in %.1f ms, %llu answers differ, max hit point diff %.2f\n",
+            options.scenePath.c_str(), scene.GetTriangleCount(), replayQueryMicros / 1000.0,
+            static_cast<unsigned long long>(answerDiffs), maxHitDiff);
+    }
+
+    uint32_t climbingFrames = 0;
+    double climbDiffTotal = 0.0;
+    const FrameReport* worstClimbFrame = nullptr;
+    for (const auto& r : reports) {
+        if (!r.climbing) {
+            continue;
+        }
+        climbingFrames++;
+        climbDiffTotal += r.climbDiff;
+        if (!worstClimbFrame || r.climbDiff > worstClimbFrame->climbDiff) {
+            worstClimbFrame = &r;
+        }
+    }
+    if (worstClimbFrame) {
+        std::printf("Climbing replay: %u frames, position diff mean %.2f, max %.2f at frame %u; %u releases, history launch speed mean %.1f\n",
+            climbingFrames, climbDiffTotal / static_cast<double>(climbingFrames), worstClimbFrame->climbDiff,
+            worstClimbFrame->frameNumber, launches, launches > 0 ? launchSpeedTotal / static_cast<double>(launches) : 0.0);
+    }
+
+    if (hasBaseline) {
+        float maxPositionDiff = 0.0f;
+        uint32_t stateDiffs = 0;
+        for (const auto& r : reports) {
+            maxPositionDiff = (std::max)(maxPositionDiff, r.positionDiff);
+            stateDiffs += r.stateDiff ? 1 : 0;
+        }
+        std::printf("Baseline %s: max position diff %.2f, %u frames with a different state", options.baselinePath.c_str(),
+            maxPositionDiff, stateDiffs);
+        if (firstDivergentFrame >= 0) {
+            std::printf(", first divergence at frame %u\n", reports[static_cast<size_t>(firstDivergentFrame)].frameNumber);
+        } else {
+            std::printf(", no divergence\n");
+        }
+    }
+
+    if (!options.csvPath.empty()) {
+        WriteCsv(options.csvPath, reports);
+    }
+
+    return 0;
+}